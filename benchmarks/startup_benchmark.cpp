@@ -0,0 +1,248 @@
+/// @file startup_benchmark.cpp
+/// Macro benchmark: registration, build, eager creation, first request,
+/// steady-state resolution and teardown on synthetic graphs.  Writes JSON.
+///
+/// Usage: librtdi_startup_benchmark [--topology=balanced] [--nodes=N]
+///            [--depth=D] [--fan-out=F] [--collection-share=0]
+///            [--forward-share=0] [--decorator-share=0] [--factory-cost=0]
+///            [--reps=5] [--iterations=100000] [--seed=1] [--out=result.json]
+///            [--list]
+///
+/// --nodes, --depth and --fan-out default to the whole topology and are
+/// rejected when they exceed it; the JSON reports the values used.
+
+#include "synthetic_graph.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct options {
+    std::string topology = "balanced";
+    synthetic::graph_spec spec;
+    std::size_t reps = 5;
+    std::size_t iterations = 100000;
+    std::string out;
+    bool list = false;
+};
+
+[[noreturn]] void usage_error(const std::string& msg) {
+    std::cerr << "librtdi_startup_benchmark: " << msg << "\n";
+    std::exit(2);
+}
+
+options parse(int argc, char** argv) {
+    options o;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--list") {
+            o.list = true;
+            continue;
+        }
+        auto eq = arg.find('=');
+        if (arg.substr(0, 2) != "--" || eq == std::string_view::npos) {
+            usage_error("unexpected argument " + std::string(arg));
+        }
+        auto key = arg.substr(2, eq - 2);
+        std::string value(arg.substr(eq + 1));
+        try {
+            if (key == "topology") o.topology = value;
+            else if (key == "nodes") o.spec.nodes = std::stoul(value);
+            else if (key == "depth") o.spec.depth = std::stoul(value);
+            else if (key == "fan-out") o.spec.fan_out = std::stoul(value);
+            else if (key == "collection-share") o.spec.collection_share = std::stod(value);
+            else if (key == "forward-share") o.spec.forward_share = std::stod(value);
+            else if (key == "decorator-share") o.spec.decorator_share = std::stod(value);
+            else if (key == "factory-cost") o.spec.factory_cost = std::stoul(value);
+            else if (key == "seed") o.spec.seed = std::stoull(value);
+            else if (key == "reps") o.reps = std::max<std::size_t>(1, std::stoul(value));
+            else if (key == "iterations") o.iterations = std::max<std::size_t>(1, std::stoul(value));
+            else if (key == "out") o.out = value;
+            else usage_error("unknown option --" + std::string(key));
+        } catch (const std::logic_error&) {
+            usage_error("bad value for --" + std::string(key));
+        }
+    }
+    return o;
+}
+
+double elapsed(clock_type::time_point start, double unit_per_second) {
+    return std::chrono::duration<double>(clock_type::now() - start).count() * unit_per_second;
+}
+
+constexpr double ms = 1e3;
+constexpr double us = 1e6;
+constexpr double ns = 1e9;
+
+// Keeps resolved pointers observable so the loops are not optimized away
+const void* volatile g_sink = nullptr;
+
+// One sample per repetition, keyed by metric name
+using samples = std::map<std::string, std::vector<double>>;
+
+synthetic::populated_graph run_once(const synthetic::topology& topo, const options& o,
+                                    samples& out) {
+    // Registration
+    librtdi::registry reg;
+    auto start = clock_type::now();
+    auto graph = synthetic::populate(reg, topo, o.spec);
+    out["registration_ms"].push_back(elapsed(start, ms));
+
+    // Build phases: compile (forward expansion, decorators, indexing),
+    // then the same with validation, then eager creation
+    librtdi::registry plain;
+    static_cast<void>(synthetic::populate(plain, topo, o.spec));
+    start = clock_type::now();
+    auto lazy_graph = plain.compile({.validate_on_build = false, .eager_singletons = false});
+    out["compile_ms"].push_back(elapsed(start, ms));
+
+    start = clock_type::now();
+    auto eager_graph = reg.compile({.validate_on_build = true, .eager_singletons = true});
+    out["compile_validated_ms"].push_back(elapsed(start, ms));
+
+    start = clock_type::now();
+    auto eager = eager_graph->instantiate();
+    out["eager_creation_ms"].push_back(elapsed(start, ms));
+
+    // First request on a lazy resolver builds the root's whole closure
+    auto lazy = lazy_graph->instantiate();
+    start = clock_type::now();
+    g_sink = lazy->create<synthetic::IRequest>().get();
+    out["first_request_us"].push_back(elapsed(start, us));
+    start = clock_type::now();
+    lazy.reset();
+    out["lazy_teardown_ms"].push_back(elapsed(start, ms));
+
+    // Steady state on the eager resolver
+    std::mt19937_64 rng(o.spec.seed);
+    std::vector<synthetic::resolve_fn> order(o.iterations);
+    std::uniform_int_distribution<std::size_t> pick(0, graph.lookups.size() - 1);
+    for (auto& fn : order) fn = graph.lookups[pick(rng)];
+
+    start = clock_type::now();
+    for (auto fn : order) g_sink = fn(*eager);
+    out["get_ns"].push_back(elapsed(start, ns) / static_cast<double>(o.iterations));
+
+    const auto get_all = topo.layers[graph.root_layer].get_all;
+    start = clock_type::now();
+    for (std::size_t i = 0; i < o.iterations; ++i) g_sink = get_all(*eager);
+    out["get_all_ns"].push_back(elapsed(start, ns) / static_cast<double>(o.iterations));
+
+    start = clock_type::now();
+    for (std::size_t i = 0; i < o.iterations; ++i) {
+        g_sink = eager->create<synthetic::IRequest>().get();
+    }
+    out["create_transient_ns"].push_back(elapsed(start, ns) / static_cast<double>(o.iterations));
+
+    start = clock_type::now();
+    for (std::size_t i = 0; i < o.iterations; ++i) {
+        g_sink = eager->create<synthetic::IStrategy>().get();
+    }
+    out["create_stateless_ns"].push_back(elapsed(start, ns) / static_cast<double>(o.iterations));
+
+    // Teardown of the fully built resolver
+    start = clock_type::now();
+    eager.reset();
+    out["teardown_ms"].push_back(elapsed(start, ms));
+    return graph;
+}
+
+std::string json_number(double v) {
+    std::ostringstream os;
+    os.precision(6);
+    os << v;
+    return os.str();
+}
+
+std::string to_json(const synthetic::topology& topo, const options& o,
+                    const synthetic::populated_graph& graph, const samples& results) {
+    const auto& s = o.spec;
+    std::ostringstream js;
+    js << "{\n"
+       << "  \"benchmark\": \"librtdi_startup\",\n"
+       << "  \"topology\": {\"name\": \"" << topo.name << "\", \"depth\": " << topo.depth
+       << ", \"width\": " << topo.width << ", \"fan_out\": " << topo.fan_out << "},\n"
+       << "  \"spec\": {\"nodes\": " << s.nodes << ", \"depth\": " << s.depth
+       << ", \"fan_out\": " << s.fan_out
+       << ", \"collection_share\": " << json_number(s.collection_share)
+       << ", \"forward_share\": " << json_number(s.forward_share)
+       << ", \"decorator_share\": " << json_number(s.decorator_share)
+       << ", \"factory_cost\": " << s.factory_cost << ", \"seed\": " << s.seed
+       << ", \"reps\": " << o.reps << ", \"iterations\": " << o.iterations << "},\n"
+       << "  \"graph\": {\"singletons\": " << graph.stats.singletons
+       << ", \"collection_members\": " << graph.stats.collection_members
+       << ", \"forwards\": " << graph.stats.forwards
+       << ", \"decorators\": " << graph.stats.decorators
+       << ", \"edges\": " << graph.stats.edges << "},\n"
+       << "  \"results\": {";
+
+    bool first = true;
+    for (auto [name, values] : results) {
+        std::sort(values.begin(), values.end());
+        js << (first ? "\n" : ",\n") << "    \"" << name << "\": {"
+           << "\"median\": " << json_number(values[values.size() / 2])
+           << ", \"min\": " << json_number(values.front())
+           << ", \"max\": " << json_number(values.back()) << "}";
+        first = false;
+    }
+    js << "\n  }\n}\n";
+    return js.str();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    auto o = parse(argc, argv);
+
+    const std::vector<std::function<synthetic::topology()>> makers{
+        synthetic::deep_topology, synthetic::wide_topology, synthetic::balanced_topology};
+    std::vector<synthetic::topology> topologies;
+    for (const auto& make : makers) topologies.push_back(make());
+
+    if (o.list) {
+        for (const auto& t : topologies) {
+            std::cout << t.name << ": depth " << t.depth << ", width " << t.width
+                      << ", fan-out " << t.fan_out << "\n";
+        }
+        return 0;
+    }
+
+    auto topo = std::find_if(topologies.begin(), topologies.end(),
+                             [&](const auto& t) { return t.name == o.topology; });
+    if (topo == topologies.end()) usage_error("unknown topology " + o.topology + " (see --list)");
+    if (auto error = synthetic::resolve_spec(*topo, o.spec); !error.empty()) usage_error(error);
+
+    synthetic::g_factory_cost = o.spec.factory_cost;
+
+    samples results;
+    synthetic::populated_graph graph;
+    try {
+        for (std::size_t rep = 0; rep < o.reps; ++rep) graph = run_once(*topo, o, results);
+    } catch (const librtdi::di_error& e) {
+        std::cerr << e.full_diagnostic() << "\n";
+        return 1;
+    }
+
+    auto json = to_json(*topo, o, graph, results);
+    if (o.out.empty()) {
+        std::cout << json;
+    } else {
+        std::ofstream(o.out) << json;
+    }
+    return 0;
+}
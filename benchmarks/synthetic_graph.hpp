@@ -0,0 +1,355 @@
+#pragma once
+
+/// @file synthetic_graph.hpp
+/// Synthetic dependency graphs for the startup/teardown benchmark.
+///
+/// Registrations are keyed by type, so the shape of a graph is fixed at
+/// compile time: a topology is `depth` layers of `width` nodes, each node
+/// depending on up to `fan_out` nodes of the next layer (and the first node
+/// of a layer also on the next layer's collection).  What gets registered
+/// from it, including the fan-out actually used, is chosen at run time by a
+/// graph_spec.
+
+#include <librtdi.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace synthetic {
+
+// ---------------------------------------------------------------
+// graph_spec — run-time selection over a topology
+// ---------------------------------------------------------------
+
+struct graph_spec {
+    std::size_t nodes = 0;            // 0 = every node of the used layers
+    std::size_t depth = 0;            // 0 = every layer; else the deepest `depth` layers
+    std::size_t fan_out = 0;          // 0 = the topology's; else the first `fan_out` edges
+    double collection_share = 0.0;    // nodes also registered in their layer's collection
+    double forward_share = 0.0;       // nodes also forwarded to an alias interface
+    double decorator_share = 0.0;     // nodes wrapped in a decorator
+    std::size_t factory_cost = 0;     // work units per factory call
+    std::uint64_t seed = 1;
+};
+
+/// What populate() registered.
+struct graph_stats {
+    std::size_t singletons = 0;
+    std::size_t collection_members = 0;
+    std::size_t forwards = 0;
+    std::size_t decorators = 0;
+    std::size_t edges = 0;
+};
+
+/// Per-resolution work of every node factory (graph_spec::factory_cost).
+inline std::size_t g_factory_cost = 0;
+
+inline std::uint64_t burn(std::uint64_t x) {
+    for (std::size_t i = 0; i < g_factory_cost; ++i) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+    }
+    return x;
+}
+
+// ---------------------------------------------------------------
+// Interfaces
+// ---------------------------------------------------------------
+
+struct node_base {
+    virtual ~node_base() = default;
+    virtual std::uint64_t value() const = 0;
+};
+
+template <std::size_t L, std::size_t I>
+struct IAlias : node_base {};
+
+template <std::size_t L, std::size_t I>
+struct INode : IAlias<L, I> {};
+
+template <std::size_t L>
+struct ILayer {
+    virtual ~ILayer() = default;
+    virtual std::uint64_t layer_value() const = 0;
+};
+
+struct IRequest {
+    virtual ~IRequest() = default;
+    virtual std::uint64_t value() const = 0;
+};
+
+struct IStrategy {
+    virtual ~IStrategy() = default;
+    virtual std::uint64_t apply(std::uint64_t x) const = 0;
+};
+
+inline std::uint64_t value_of(const node_base& n) { return n.value(); }
+
+template <std::size_t L>
+std::uint64_t value_of(const std::vector<ILayer<L>*>& members) {
+    std::uint64_t sum = 0;
+    for (const auto* m : members) sum += m->layer_value();
+    return sum;
+}
+
+// ---------------------------------------------------------------
+// Implementations
+// ---------------------------------------------------------------
+
+template <typename Topo, std::size_t L, std::size_t I>
+struct Node final : INode<L, I>, ILayer<L> {
+    template <typename... Deps>
+    explicit Node(Deps&&... deps)
+        : value_(burn((L << 16 | I) + 1 + (std::uint64_t{0} + ... + value_of(deps)))) {}
+
+    std::uint64_t value() const override { return value_; }
+    std::uint64_t layer_value() const override { return value_; }
+
+private:
+    std::uint64_t value_;
+};
+
+template <std::size_t L, std::size_t I>
+struct Traced final : INode<L, I> {
+    explicit Traced(librtdi::decorated_ptr<INode<L, I>> inner) : inner_(std::move(inner)) {}
+    std::uint64_t value() const override { return inner_->value() + 1; }
+
+private:
+    librtdi::decorated_ptr<INode<L, I>> inner_;
+};
+
+// Stateless: its zero-dependency transient registration is folded
+struct Strategy final : IStrategy {
+    std::uint64_t apply(std::uint64_t x) const override { return x + 1; }
+};
+
+template <std::size_t L>
+struct Request final : IRequest {
+    explicit Request(INode<L, 0>& root) : root_(root) {}
+    std::uint64_t value() const override { return root_.value(); }
+
+private:
+    INode<L, 0>& root_;
+};
+
+// ---------------------------------------------------------------
+// topology — compile-time shape plus one operation table per node
+// ---------------------------------------------------------------
+
+using resolve_fn = const void* (*)(librtdi::resolver&);
+
+struct node_ops {
+    void (*add)(librtdi::registry&, std::size_t fan_out);
+    void (*add_member)(librtdi::registry&, std::size_t fan_out);
+    void (*add_forward)(librtdi::registry&);
+    void (*add_decorator)(librtdi::registry&);
+    resolve_fn get;
+    resolve_fn get_alias;
+};
+
+struct layer_ops {
+    resolve_fn get_all;
+    void (*add_request)(librtdi::registry&);
+};
+
+struct topology {
+    std::string name;
+    std::size_t depth;
+    std::size_t width;
+    std::size_t fan_out;
+    std::vector<node_ops> nodes;     // layer-major
+    std::vector<layer_ops> layers;
+};
+
+template <std::size_t Depth, std::size_t Width, std::size_t FanOut>
+struct shape {
+    static constexpr std::size_t depth = Depth;
+    static constexpr std::size_t width = Width;
+    static constexpr std::size_t fan_out = FanOut;
+};
+
+namespace detail {
+
+template <typename Topo, std::size_t L, std::size_t I, std::size_t... K>
+constexpr auto node_deps(std::index_sequence<K...>) {
+    if constexpr (L + 1 == Topo::depth) {
+        return librtdi::deps<>;
+    } else if constexpr (I == 0) {
+        return librtdi::deps<INode<L + 1, (I * Topo::fan_out + K) % Topo::width>...,
+                             librtdi::collection<ILayer<L + 1>>>;
+    } else {
+        return librtdi::deps<INode<L + 1, (I * Topo::fan_out + K) % Topo::width>...>;
+    }
+}
+
+template <typename Topo, std::size_t L, std::size_t I, std::size_t FanOut>
+void add_node(librtdi::registry& reg) {
+    static constexpr auto deps = node_deps<Topo, L, I>(std::make_index_sequence<FanOut>{});
+    reg.add_singleton<INode<L, I>, Node<Topo, L, I>>(deps);
+}
+
+template <typename Topo, std::size_t L, std::size_t I, std::size_t FanOut>
+void add_member(librtdi::registry& reg) {
+    static constexpr auto deps = node_deps<Topo, L, I>(std::make_index_sequence<FanOut>{});
+    reg.add_collection<ILayer<L>, Node<Topo, L, I>>(librtdi::lifetime_kind::singleton, deps);
+}
+
+// One registration per fan-out 1..Topo::fan_out, picked at run time
+template <typename Topo, std::size_t L, std::size_t I, std::size_t... K>
+void add_node_with(librtdi::registry& reg, std::size_t fan_out, std::index_sequence<K...>) {
+    static constexpr void (*table[])(librtdi::registry&) = {&add_node<Topo, L, I, K + 1>...};
+    table[fan_out - 1](reg);
+}
+
+template <typename Topo, std::size_t L, std::size_t I, std::size_t... K>
+void add_member_with(librtdi::registry& reg, std::size_t fan_out, std::index_sequence<K...>) {
+    static constexpr void (*table[])(librtdi::registry&) = {&add_member<Topo, L, I, K + 1>...};
+    table[fan_out - 1](reg);
+}
+
+template <typename Topo, std::size_t L, std::size_t I>
+node_ops make_node_ops() {
+    using fan_outs = std::make_index_sequence<Topo::fan_out>;
+    return {
+        [](librtdi::registry& reg, std::size_t fan_out) {
+            add_node_with<Topo, L, I>(reg, fan_out, fan_outs{});
+        },
+        [](librtdi::registry& reg, std::size_t fan_out) {
+            add_member_with<Topo, L, I>(reg, fan_out, fan_outs{});
+        },
+        [](librtdi::registry& reg) { reg.forward<IAlias<L, I>, INode<L, I>>(); },
+        [](librtdi::registry& reg) { reg.decorate<INode<L, I>, Traced<L, I>>(); },
+        [](librtdi::resolver& r) -> const void* { return &r.get<INode<L, I>>(); },
+        [](librtdi::resolver& r) -> const void* { return &r.get<IAlias<L, I>>(); },
+    };
+}
+
+template <std::size_t L>
+layer_ops make_layer_ops() {
+    return {
+        [](librtdi::resolver& r) -> const void* {
+            auto members = r.get_all<ILayer<L>>();
+            return members.empty() ? nullptr : members.front();
+        },
+        [](librtdi::registry& reg) {
+            reg.add_transient<IRequest, Request<L>>(librtdi::deps<INode<L, 0>>);
+        },
+    };
+}
+
+template <typename Topo, std::size_t... N>
+std::vector<node_ops> all_node_ops(std::index_sequence<N...>) {
+    return {make_node_ops<Topo, N / Topo::width, N % Topo::width>()...};
+}
+
+template <std::size_t... L>
+std::vector<layer_ops> all_layer_ops(std::index_sequence<L...>) {
+    return {make_layer_ops<L>()...};
+}
+
+} // namespace detail
+
+/// Operation tables of shape `Topo`; instantiated once per topology in its
+/// own translation unit to keep compile times manageable.
+template <typename Topo>
+topology make_topology(std::string name) {
+    static_assert(Topo::fan_out >= 1 && Topo::fan_out <= Topo::width);
+    return {
+        std::move(name), Topo::depth, Topo::width, Topo::fan_out,
+        detail::all_node_ops<Topo>(std::make_index_sequence<Topo::depth * Topo::width>{}),
+        detail::all_layer_ops(std::make_index_sequence<Topo::depth>{}),
+    };
+}
+
+// One translation unit each (topology_<name>.cpp)
+topology deep_topology();
+topology wide_topology();
+topology balanced_topology();
+
+// ---------------------------------------------------------------
+// populate — register a graph_spec's selection of a topology
+// ---------------------------------------------------------------
+
+/// A registered graph: the nodes to resolve from and what was registered.
+struct populated_graph {
+    std::size_t root_layer = 0;
+    std::vector<resolve_fn> lookups;   // one per registered node (alias if forwarded)
+    graph_stats stats;
+};
+
+/// `spec` with its zero ("all") fields replaced by what the topology
+/// offers.  Returns an empty string, or why `spec` does not fit `topo`.
+inline std::string resolve_spec(const topology& topo, graph_spec& spec) {
+    if (spec.depth > topo.depth) {
+        return "--depth=" + std::to_string(spec.depth) + " exceeds the "
+               + std::to_string(topo.depth) + " layers of " + topo.name;
+    }
+    if (spec.depth == 0) spec.depth = topo.depth;
+    const std::size_t total = spec.depth * topo.width;
+    if (spec.nodes > total) {
+        return "--nodes=" + std::to_string(spec.nodes) + " exceeds the "
+               + std::to_string(total) + " nodes of " + std::to_string(spec.depth)
+               + " layers of " + topo.name;
+    }
+    if (spec.nodes == 0) spec.nodes = total;
+    if (spec.fan_out > topo.fan_out) {
+        return "--fan-out=" + std::to_string(spec.fan_out) + " exceeds the fan-out "
+               + std::to_string(topo.fan_out) + " of " + topo.name;
+    }
+    if (spec.fan_out == 0) spec.fan_out = topo.fan_out;
+    return {};
+}
+
+/// Register the deepest layers first so that every node's dependencies
+/// are registered before the node count runs out.  `spec` must have been
+/// through resolve_spec().
+inline populated_graph populate(librtdi::registry& reg, const topology& topo,
+                                const graph_spec& spec) {
+    std::mt19937_64 rng(spec.seed);
+    std::uniform_real_distribution<double> share(0.0, 1.0);
+
+    const std::size_t layers = spec.depth;
+    const std::size_t budget = spec.nodes;
+
+    populated_graph out;
+    out.root_layer = topo.depth - layers;
+    reg.add_transient<IStrategy, Strategy>();
+    std::size_t added = 0;
+    for (std::size_t l = topo.depth; l-- > out.root_layer && added < budget;) {
+        for (std::size_t i = 0; i < topo.width && added < budget; ++i, ++added) {
+            const auto& ops = topo.nodes[l * topo.width + i];
+            ops.add(reg, spec.fan_out);
+            ++out.stats.singletons;
+            if (l + 1 < topo.depth) out.stats.edges += spec.fan_out + (i == 0 ? 1 : 0);
+
+            if (share(rng) < spec.collection_share) {
+                ops.add_member(reg, spec.fan_out);
+                ++out.stats.collection_members;
+            }
+            if (share(rng) < spec.decorator_share) {
+                ops.add_decorator(reg);
+                ++out.stats.decorators;
+            }
+            if (share(rng) < spec.forward_share) {
+                ops.add_forward(reg);
+                ++out.stats.forwards;
+                out.lookups.push_back(ops.get_alias);
+            } else {
+                out.lookups.push_back(ops.get);
+            }
+        }
+        if (l == out.root_layer || added == budget) {
+            // The topmost (possibly partial) layer: its first node is the root
+            topo.layers[l].add_request(reg);
+            out.root_layer = l;
+        }
+    }
+    return out;
+}
+
+} // namespace synthetic
@@ -0,0 +1,12 @@
+/// @file topology_balanced.cpp
+/// "balanced" topology: a mid-sized service graph.
+
+#include "synthetic_graph.hpp"
+
+namespace synthetic {
+
+topology balanced_topology() {
+    return make_topology<shape<10, 16, 3>>("balanced");
+}
+
+} // namespace synthetic
@@ -0,0 +1,12 @@
+/// @file topology_deep.cpp
+/// "deep" topology: a long chain of narrow layers.
+
+#include "synthetic_graph.hpp"
+
+namespace synthetic {
+
+topology deep_topology() {
+    return make_topology<shape<24, 4, 2>>("deep");
+}
+
+} // namespace synthetic
@@ -0,0 +1,12 @@
+/// @file topology_wide.cpp
+/// "wide" topology: few layers of many nodes.
+
+#include "synthetic_graph.hpp"
+
+namespace synthetic {
+
+topology wide_topology() {
+    return make_topology<shape<3, 48, 4>>("wide");
+}
+
+} // namespace synthetic
@@ -5,8 +5,10 @@
 #include "librtdi/lifetime.hpp"
 #include "librtdi/erased_ptr.hpp"
 #include "librtdi/decorated_ptr.hpp"
+#include "librtdi/refreshable.hpp"
 #include "librtdi/descriptor.hpp"
 #include "librtdi/exceptions.hpp"
 #include "librtdi/type_traits.hpp"
+#include "librtdi/compiled_graph.hpp"
 #include "librtdi/registry.hpp"
 #include "librtdi/resolver.hpp"
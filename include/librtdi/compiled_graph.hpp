@@ -0,0 +1,48 @@
+#pragma once
+
+#include "export.hpp"
+#include "descriptor.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace librtdi {
+
+namespace internal {
+struct resolver_graph;
+} // namespace internal
+
+// ---------------------------------------------------------------
+// compiled_graph — validated, immutable descriptor tables
+// ---------------------------------------------------------------
+
+/// Result of `registry::compile()`: forwards expanded, decorators applied,
+/// validation done.  Every `instantiate()` call creates an independent
+/// resolver that shares these tables and owns only its singleton cache,
+/// so creating many containers for one graph costs O(singletons) each.
+class LIBRTDI_EXPORT compiled_graph {
+public:
+    ~compiled_graph();
+
+    compiled_graph(const compiled_graph&) = delete;
+    compiled_graph& operator=(const compiled_graph&) = delete;
+
+    /// Create a new resolver over this graph.  Honors the `build_options`
+    /// given to `compile()` (e.g. eager singleton creation).
+    std::shared_ptr<resolver> instantiate() const;
+
+    /// The compiled descriptor table (after forward expansion / decoration).
+    const std::vector<descriptor>& descriptors() const;
+
+    /// The options this graph was compiled with.
+    const build_options& options() const;
+
+private:
+    friend class registry;
+
+    explicit compiled_graph(std::shared_ptr<const internal::resolver_graph> graph);
+
+    std::shared_ptr<const internal::resolver_graph> graph_;
+};
+
+} // namespace librtdi
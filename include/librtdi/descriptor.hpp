@@ -6,10 +6,15 @@
 #include "export.hpp"
 
 #include <any>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <optional>
 #include <source_location>
 #include <string>
+#include <string_view>
 #include <typeindex>
 #include <vector>
 
@@ -17,7 +22,98 @@ namespace librtdi {
 
 using factory_fn = std::function<erased_ptr(resolver&)>;
 
-using forward_cast_fn = std::function<void*(void*)>;
+/// Direct constructor of a stateless transient (descriptor::stateless).
+using stateless_fn = erased_ptr (*)();
+
+// ---------------------------------------------------------------
+// forward_cast_fn — TTarget* → TInterface* adjustment of a forward
+// ---------------------------------------------------------------
+
+/// Pointer adjustment applied by forwarded resolutions.  Chosen per
+/// registration: a constant offset (non-virtual base, learned from the
+/// first instance), a plain function pointer, or a type-erased callable.
+class forward_cast_fn {
+public:
+    using function_ptr = void* (*)(void*);
+
+    forward_cast_fn() noexcept = default;
+    forward_cast_fn(std::nullptr_t) noexcept {}
+
+    /// Arbitrary callable (kept for custom adjustments).
+    forward_cast_fn(std::function<void*(void*)> fn)
+        : kind_(fn ? kind::callable : kind::none), callable_(std::move(fn)) {}
+
+    /// Call `fn` for every adjustment (virtual bases, whose offset
+    /// depends on the dynamic type).
+    static forward_cast_fn function(function_ptr fn) noexcept {
+        forward_cast_fn f;
+        f.kind_ = kind::function;
+        f.fn_ = fn;
+        return f;
+    }
+
+    /// `probe` performs a cast whose offset is the same for every object;
+    /// it runs once and the offset is reused afterwards.
+    static forward_cast_fn constant_offset(function_ptr probe) noexcept {
+        forward_cast_fn f;
+        f.kind_ = kind::offset;
+        f.fn_ = probe;
+        return f;
+    }
+
+    forward_cast_fn(const forward_cast_fn& o)
+        : kind_(o.kind_), fn_(o.fn_), callable_(o.callable_)
+        , offset_(o.offset_.load(std::memory_order_relaxed)) {}
+
+    forward_cast_fn& operator=(const forward_cast_fn& o) {
+        if (this != &o) {
+            kind_ = o.kind_;
+            fn_ = o.fn_;
+            callable_ = o.callable_;
+            offset_.store(o.offset_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        return *this;
+    }
+
+    explicit operator bool() const noexcept { return kind_ != kind::none; }
+
+    void* operator()(void* p) const {
+        switch (kind_) {
+        case kind::none:
+            return p;
+        case kind::offset: {
+            if (!p) return nullptr;
+            auto off = offset_.load(std::memory_order_relaxed);
+            if (off == unknown_offset) {
+                void* adjusted = fn_(p);
+                offset_.store(static_cast<char*>(adjusted) - static_cast<char*>(p),
+                              std::memory_order_relaxed);
+                return adjusted;
+            }
+            return static_cast<char*>(p) + off;
+        }
+        case kind::function:
+            return fn_(p);
+        case kind::callable:
+            return callable_(p);
+        }
+        return p;
+    }
+
+private:
+    enum class kind : unsigned char { none, offset, function, callable };
+
+    static constexpr std::ptrdiff_t unknown_offset = PTRDIFF_MIN;
+
+    kind kind_ = kind::none;
+    function_ptr fn_ = nullptr;
+    std::function<void*(void*)> callable_;
+    mutable std::atomic<std::ptrdiff_t> offset_{unknown_offset};
+};
+
+/// Entry point exported by a plugin shared object (see registry::add_plugin).
+/// Stores an owning pointer to the *interface* type in `out`.
+using plugin_entry_fn = void (*)(resolver& r, erased_ptr& out);
 
 namespace internal {
 /// Capture a stacktrace at the current call site.
@@ -25,8 +121,71 @@ namespace internal {
 /// or an empty std::any otherwise.  Implemented in a .cpp file so
 /// that Boost headers are not required in public headers.
 LIBRTDI_EXPORT std::any capture_stacktrace();
+
+/// Key of the singleton-family member whose factory is running on this
+/// thread (registry::add_singleton_family); empty outside one.
+LIBRTDI_EXPORT std::string_view current_family_key() noexcept;
 } // namespace internal
 
+// ---------------------------------------------------------------
+// exit_policy — what resolver teardown does with a created singleton
+// ---------------------------------------------------------------
+
+enum class exit_policy {
+    inherit,   // destroy, unless build_options::fast_exit is set
+    destroy,   // always run the destructor (flush, close sockets, ...)
+    leak       // never run the destructor; the OS reclaims the memory
+};
+
+// ---------------------------------------------------------------
+// fork_policy — what resolver::after_fork_child() does with a singleton
+// ---------------------------------------------------------------
+
+enum class fork_policy {
+    keep,          // share the parent's instance copy-on-write
+    reinitialize   // per-process state (threads, fds): re-create in the child
+};
+
+// ---------------------------------------------------------------
+// task_executor — runs collection members in parallel
+// ---------------------------------------------------------------
+
+/// Schedules a task, e.g. on a thread pool.  Every submitted task must
+/// eventually run; running it inline is allowed.
+using task_executor = std::function<void(std::function<void()>)>;
+
+// ---------------------------------------------------------------
+// construction_deadline — watchdog thresholds for one factory call
+// ---------------------------------------------------------------
+
+struct construction_deadline {
+    /// Report the factory as slow once it has run this long.  0 = off.
+    std::chrono::milliseconds soft{0};
+
+    /// Report it, request cancellation through
+    /// resolver::construction_stop_token() and, during startup, fail
+    /// build() with construction_timeout.  0 = off.
+    std::chrono::milliseconds hard{0};
+
+    bool operator==(const construction_deadline&) const = default;
+};
+
+/// One factory call that ran past its construction_deadline.
+struct slow_factory_report {
+    std::type_index component_type;
+    std::optional<std::type_index> impl_type;
+    std::source_location registration_location;
+    std::vector<std::type_index> resolution_chain;   ///< outermost first, ends with component_type
+    std::chrono::milliseconds elapsed{0};
+    std::chrono::milliseconds deadline{0};            ///< the threshold that was passed
+    bool hard_timeout = false;
+    std::string message;             ///< one-line summary with the resolution chain
+    std::string diagnostic_detail;   ///< registration trace, if captured
+};
+
+/// Receives watchdog reports; called on the watchdog thread.
+using slow_factory_handler = std::function<void(const slow_factory_report&)>;
+
 // ---------------------------------------------------------------
 // build_options — controls build-time behaviour
 // ---------------------------------------------------------------
@@ -37,6 +196,50 @@ struct build_options {
     bool detect_cycles            = true;
     bool eager_singletons         = true;
     bool allow_empty_collections  = true;
+
+    /// Eager creation keeps going past failing factories: every singleton
+    /// whose dependencies were built is attempted, dependents of failed ones
+    /// are skipped, and one eager_construction_error lists all failures.
+    bool collect_eager_errors     = false;
+
+    /// Process-exit mode: resolver teardown only destroys singletons whose
+    /// exit_policy is `destroy`; every other created singleton is leaked.
+    bool fast_exit                = false;
+
+    /// resolver::after_fork_child(): destroy the stale parent instances of
+    /// re-initialized singletons instead of leaking them.  Leaving them
+    /// untouched (the default) keeps their pages shared copy-on-write.
+    bool destroy_stale_on_fork    = false;
+
+    /// Upper bound on the accounted size of resident evictable singletons.
+    /// Creating one past the budget evicts the least recently used others.
+    /// 0 = unlimited (evict only through resolver::trim()).
+    std::size_t eviction_budget   = 0;
+
+    /// Default executor for get_all<T>() / create_all<T>() called outside
+    /// a factory: collection members that do not depend on each other are
+    /// constructed in parallel on it.  Empty = sequential.
+    task_executor collection_executor{};
+
+    /// Ordered startup phases (e.g. {"critical", "serving", "background"}).
+    /// Singletons assigned to a phase are constructed phase by phase, each
+    /// with its dependency closure, whether or not eager_singletons is set;
+    /// the remaining singletons follow eager_singletons after the last
+    /// phase.  See resolver::phase_ready().
+    std::vector<std::string> startup_phases{};
+
+    /// Runs the startup phases in the background so that build() returns
+    /// before they finish.  Empty = build() constructs every phase first.
+    task_executor phase_executor{};
+
+    /// Default deadline of every factory call; registrations override it
+    /// with registry::set_construction_deadline().  Any non-zero deadline
+    /// starts a watchdog thread for the resolver.
+    construction_deadline factory_deadline{};
+
+    /// Receives slow-factory and hard-timeout reports.  Empty = reports are
+    /// dropped (a hard timeout during startup still fails build()).
+    slow_factory_handler on_slow_factory{};
 };
 
 // ---------------------------------------------------------------
@@ -47,10 +250,25 @@ struct dependency_info {
     std::type_index type;
     bool is_collection = false;
     bool is_transient  = false;
+    bool is_refreshable = false;   // declared via refreshable<T>
+    std::optional<std::type_index> exact_impl{};   // TImpl of exact<I, TImpl>
+    std::string key{};                             // Key of keyed<D, Key>; empty = non-keyed
 
     bool operator==(const dependency_info&) const = default;
 };
 
+// ---------------------------------------------------------------
+// toggle_layer — a decorator that can be switched per resolver
+// ---------------------------------------------------------------
+
+/// One `decorate_toggleable<I, D>()` layer of a descriptor.  `wrap` builds
+/// a D around `inner` (owning for transients, non-owning for singletons).
+struct toggle_layer {
+    std::type_index decorator_type;
+    std::function<erased_ptr(resolver&, erased_ptr inner)> wrap;
+    bool enabled = false;   // initial state in every resolver
+};
+
 // ---------------------------------------------------------------
 // descriptor — one component registration record
 // ---------------------------------------------------------------
@@ -80,6 +298,58 @@ struct descriptor {
     /// Name of the public API that created this descriptor (e.g. "add_singleton",
     /// "forward", "decorate").  Used in diagnostic stacktrace output headers.
     std::string api_name;
+
+    /// Teardown behaviour for singleton instances of this descriptor.
+    exit_policy on_exit = exit_policy::inherit;
+
+    /// Post-fork behaviour for singleton instances of this descriptor.
+    fork_policy on_fork = fork_policy::keep;
+
+    /// Singleton published through an atomically swappable cell
+    /// (registry::add_refreshable); resolved via resolver::acquire<T>().
+    bool refreshable = false;
+
+    /// Singleton that the resolver may destroy under memory pressure and
+    /// re-create on the next acquire<T>() (registry::add_evictable).
+    bool evictable = false;
+
+    /// Bytes charged against build_options::eviction_budget while an
+    /// evictable instance is resident.
+    std::size_t accounted_size = 0;
+
+    /// Singleton family (registry::add_singleton_family): one instance per
+    /// runtime key, created on the first resolver::get<T>(key).
+    bool family = false;
+
+    /// Most family members kept resident; past it the least recently
+    /// resolved one is evicted.  0 = unbounded.
+    std::size_t family_capacity = 0;
+
+    /// Undecorated forward singleton: global index of the target
+    /// descriptor whose cache entry it shares (adjusted by forward_cast).
+    std::optional<std::size_t> alias_of{};
+
+    /// Wrapped by at least one decorator, so the instance is no longer
+    /// `impl_type` and cannot satisfy exact<I, TImpl>.
+    bool decorated = false;
+
+    /// Zero-dependency transient of a stateless_impl type: built by this
+    /// plain function instead of `factory`, without a resolution frame.
+    /// Cleared by build() when a decorator or static chain replaces the
+    /// factory.
+    stateless_fn stateless = nullptr;
+
+    /// Toggleable decorators, outermost last; applied over `factory` only
+    /// while enabled in the resolving resolver.
+    std::vector<toggle_layer> toggles{};
+
+    /// Named startup phase (registry::set_startup_phase) in which the
+    /// singleton is constructed; empty = not phased.
+    std::string startup_phase{};
+
+    /// Watchdog thresholds (registry::set_construction_deadline); a zero
+    /// field falls back to build_options::factory_deadline.
+    construction_deadline deadline{};
 };
 
 } // namespace librtdi
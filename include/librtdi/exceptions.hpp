@@ -2,6 +2,8 @@
 
 #include "export.hpp"
 
+#include <chrono>
+#include <exception>
 #include <stdexcept>
 #include <optional>
 #include <string>
@@ -34,9 +36,9 @@ public:
     LIBRTDI_EXPORT std::string full_diagnostic() const;
 
     /// Append resolution context to this exception.  When a factory throws
-    /// during dependency resolution, each enclosing resolver layer appends
-    /// its component info so that the final what() message shows the full
-    /// resolution chain, e.g.:
+    /// during dependency resolution, the outermost resolver layer appends
+    /// the component info of every level so that the final what() message
+    /// shows the full resolution chain, e.g.:
     ///   "... (while resolving B [impl: BImpl]) (while resolving A [impl: AImpl])"
     /// May be called multiple times for nested resolution chains.
     void append_resolution_context(const std::string& component_info);
@@ -134,4 +136,49 @@ private:
     std::type_index component_type_;
 };
 
+/// Thrown by eager singleton creation when `build_options::collect_eager_errors`
+/// is set: lists every factory that failed, plus the singletons that were
+/// not attempted because something they depend on failed.
+class LIBRTDI_EXPORT eager_construction_error : public di_error {
+public:
+    struct failure {
+        std::type_index component_type;
+        std::optional<std::type_index> impl_type;
+        std::string message;             ///< what() of the original error, with its resolution chain
+        std::string diagnostic_detail;   ///< registration trace, if captured
+        std::exception_ptr error;        ///< the original exception
+    };
+
+    eager_construction_error(std::vector<failure> failures,
+                             std::vector<std::type_index> skipped,
+                             std::source_location loc = std::source_location::current());
+
+    const std::vector<failure>& failures() const noexcept { return failures_; }
+    const std::vector<std::type_index>& skipped() const noexcept { return skipped_; }
+
+private:
+    std::vector<failure> failures_;
+    std::vector<std::type_index> skipped_;
+
+    static std::string build_message(const std::vector<failure>& failures,
+                                     const std::vector<std::type_index>& skipped);
+};
+
+/// A factory ran past its hard construction_deadline during startup;
+/// build() (or the startup phase futures) fail with this error while the
+/// factory itself is asked to stop through its construction stop token.
+class LIBRTDI_EXPORT construction_timeout : public di_error {
+public:
+    construction_timeout(std::type_index type, std::chrono::milliseconds elapsed,
+                         const std::string& message,
+                         std::source_location loc = std::source_location::current());
+
+    std::type_index component_type() const noexcept { return component_type_; }
+    std::chrono::milliseconds elapsed() const noexcept { return elapsed_; }
+
+private:
+    std::type_index component_type_;
+    std::chrono::milliseconds elapsed_;
+};
+
 } // namespace librtdi
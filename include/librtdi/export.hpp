@@ -20,3 +20,14 @@
 #else
   #define LIBRTDI_EXPORT
 #endif
+
+/// Declares a plugin entry point (see registry::add_plugin) with C linkage
+/// and default visibility, e.g.
+///   LIBRTDI_PLUGIN_EXPORT void make_codec(librtdi::resolver&, librtdi::erased_ptr&);
+#if defined(_WIN32) || defined(__CYGWIN__)
+  #define LIBRTDI_PLUGIN_EXPORT extern "C" __declspec(dllexport)
+#elif defined(__GNUC__) || defined(__clang__)
+  #define LIBRTDI_PLUGIN_EXPORT extern "C" __attribute__((visibility("default")))
+#else
+  #define LIBRTDI_PLUGIN_EXPORT extern "C"
+#endif
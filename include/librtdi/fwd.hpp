@@ -21,7 +21,16 @@ struct erased_ptr;
 template <typename I>
 struct decorated_ptr;
 
+// refreshable.hpp
+template <typename T>
+class read_guard;
+template <typename T>
+class refreshable_ref;
+class refresh_subscription;
+
 // descriptor.hpp
+enum class exit_policy;
+enum class fork_policy;
 struct build_options;
 struct dependency_info;
 struct descriptor;
@@ -37,6 +46,9 @@ class resolution_error;
 // resolver.hpp
 class resolver;
 
+// compiled_graph.hpp
+class compiled_graph;
+
 // registry.hpp
 template <typename... Deps>
 struct deps_tag;
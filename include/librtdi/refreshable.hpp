@@ -0,0 +1,98 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace librtdi {
+
+class resolver;
+
+// ---------------------------------------------------------------
+// read_guard<T> — keeps one published refreshable instance alive
+// ---------------------------------------------------------------
+
+/// Returned by `resolver::acquire<T>()`.  The guarded instance stays valid
+/// for the guard's lifetime even if `refresh<T>()` publishes a replacement;
+/// the old instance is destroyed when its last guard is released.  Guards
+/// must not outlive the resolver.
+template <typename T>
+class read_guard {
+public:
+    read_guard() = default;
+
+    explicit read_guard(std::shared_ptr<void> instance) noexcept
+        : instance_(std::move(instance))
+        , ptr_(static_cast<T*>(instance_.get()))
+    {}
+
+    T* get() const noexcept { return ptr_; }
+    T& operator*() const noexcept { return *ptr_; }
+    T* operator->() const noexcept { return ptr_; }
+    explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+private:
+    std::shared_ptr<void> instance_;
+    T* ptr_ = nullptr;
+};
+
+// ---------------------------------------------------------------
+// refreshable_ref<T> — injected for a `refreshable<T>` dependency
+// ---------------------------------------------------------------
+
+/// A handle to a refreshable slot.  Consumers keep the handle and call
+/// `acquire()` whenever they need the current instance.
+template <typename T>
+class refreshable_ref {
+public:
+    explicit refreshable_ref(resolver& r) noexcept : resolver_(&r) {}
+
+    /// Guard over the currently published instance.
+    read_guard<T> acquire() const;
+
+private:
+    resolver* resolver_;
+};
+
+// ---------------------------------------------------------------
+// refresh_subscription — RAII handle for an on_refresh<T>() callback
+// ---------------------------------------------------------------
+
+/// Unsubscribes when destroyed (or on `reset()`).
+class refresh_subscription {
+public:
+    refresh_subscription() = default;
+
+    explicit refresh_subscription(std::function<void()> cancel)
+        : cancel_(std::move(cancel))
+    {}
+
+    refresh_subscription(refresh_subscription&& o) noexcept
+        : cancel_(std::exchange(o.cancel_, nullptr))
+    {}
+
+    refresh_subscription& operator=(refresh_subscription&& o) noexcept {
+        if (this != &o) {
+            reset();
+            cancel_ = std::exchange(o.cancel_, nullptr);
+        }
+        return *this;
+    }
+
+    refresh_subscription(const refresh_subscription&) = delete;
+    refresh_subscription& operator=(const refresh_subscription&) = delete;
+
+    ~refresh_subscription() { reset(); }
+
+    void reset() noexcept {
+        if (cancel_) {
+            auto cancel = std::exchange(cancel_, nullptr);
+            cancel();
+        }
+    }
+
+private:
+    std::function<void()> cancel_;
+};
+
+} // namespace librtdi
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "export.hpp"
+#include "compiled_graph.hpp"
 #include "decorated_ptr.hpp"
 #include "descriptor.hpp"
 #include "resolver.hpp"
@@ -8,6 +9,7 @@
 #include "type_traits.hpp"
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <source_location>
@@ -32,42 +34,51 @@ template <typename... Deps>
 inline constexpr deps_tag<Deps...> deps{};
 
 // ---------------------------------------------------------------
-// Helper: resolve a single dep at factory-call time
+// Helper: construct TImpl from its deps at factory-call time
 // ---------------------------------------------------------------
 namespace detail {
 
-template <typename D>
-auto resolve_dep(resolver& r) -> inject_type_t<D> {
-    using traits = dep_traits<D>;
-    using I = typename traits::interface_type;
-
-    if constexpr (traits::is_collection && traits::is_transient) {
-        // collection<transient<T>> → vector<unique_ptr<T>>
-        return r.create_all<I>();
-    } else if constexpr (traits::is_collection && !traits::is_transient) {
-        // collection<T> → vector<T*>
-        return r.get_all<I>();
-    } else if constexpr (!traits::is_collection && traits::is_transient) {
-        // transient<T> → unique_ptr<T>
-        return r.create<I>();
+/// Resolve every dep in one resolver::get_many() batch and construct TImpl.
+template <typename TInterface, typename TImpl, typename... Deps>
+erased_ptr make_with_deps(resolver& r) {
+    return std::apply([](auto&&... args) {
+        return make_erased_as<TInterface, TImpl>(std::forward<decltype(args)>(args)...);
+    }, r.get_many<Deps...>());
+}
+
+/// Construct a singleton-family member for the key being resolved.
+template <typename TInterface, typename TImpl, typename... Deps>
+erased_ptr make_family_member(resolver& r) {
+    // Read before resolving deps, which may build members of other families
+    const std::string key(internal::current_family_key());
+    return std::apply([&key](auto&&... args) {
+        return make_erased_as<TInterface, TImpl>(std::string_view(key),
+                                                 std::forward<decltype(args)>(args)...);
+    }, r.get_many<Deps...>());
+}
+
+/// Direct constructor of a transient TImpl registered with no deps, or
+/// nullptr when TImpl has deps or is not stateless_impl.
+template <typename TInterface, typename TImpl, typename... Deps>
+constexpr stateless_fn stateless_factory() noexcept {
+    if constexpr (sizeof...(Deps) == 0 && stateless_impl<TImpl>) {
+        return [] { return make_erased_as<TInterface, TImpl>(); };
     } else {
-        // bare T / singleton<T> → T&
-        return r.get<I>();
+        return nullptr;
     }
 }
 
 /// Build a vector<dependency_info> from deps type list.
 template <typename... Deps>
 std::vector<dependency_info> make_dep_infos() {
-    return { dependency_info{
-        std::type_index(typeid(typename dep_traits<Deps>::interface_type)),
-        dep_traits<Deps>::is_collection,
-        dep_traits<Deps>::is_transient
-    }... };
+    return { dep_info_of<Deps>()... };
 }
 
 } // namespace detail
 
+/// Guard of an add_variant() registration, evaluated once by build().
+using variant_predicate = std::function<bool()>;
+
 // ---------------------------------------------------------------
 // registry
 // ---------------------------------------------------------------
@@ -112,7 +123,7 @@ public:
         return register_single(
             typeid(TInterface), lifetime_kind::singleton,
             [](resolver& r) -> erased_ptr {
-                return make_erased_as<TInterface, TImpl>(detail::resolve_dep<Deps>(r)...);
+                return detail::make_with_deps<TInterface, TImpl, Deps...>(r);
             },
             detail::make_dep_infos<Deps...>(), {},
             std::type_index(typeid(TImpl)), loc,
@@ -145,7 +156,7 @@ public:
         return register_single(
             typeid(TInterface), lifetime_kind::singleton,
             [](resolver& r) -> erased_ptr {
-                return make_erased_as<TInterface, TImpl>(detail::resolve_dep<Deps>(r)...);
+                return detail::make_with_deps<TInterface, TImpl, Deps...>(r);
             },
             detail::make_dep_infos<Deps...>(), std::string(key),
             std::type_index(typeid(TImpl)), loc,
@@ -163,11 +174,12 @@ public:
         static_assert(std::is_same_v<TInterface, TImpl>
                    || std::has_virtual_destructor_v<TInterface>,
             "add_transient<I,T>: I must have a virtual destructor when I != T");
-        return register_single(
+        register_single(
             typeid(TInterface), lifetime_kind::transient,
             [](resolver&) -> erased_ptr { return make_erased_as<TInterface, TImpl>(); },
             {}, {}, std::type_index(typeid(TImpl)), loc,
             internal::capture_stacktrace(), "add_transient");
+        return fold_stateless(detail::stateless_factory<TInterface, TImpl>());
     }
 
     template <typename TInterface, typename TImpl, typename... Deps>
@@ -177,14 +189,15 @@ public:
         static_assert(std::is_same_v<TInterface, TImpl>
                    || std::has_virtual_destructor_v<TInterface>,
             "add_transient<I,T>: I must have a virtual destructor when I != T");
-        return register_single(
+        register_single(
             typeid(TInterface), lifetime_kind::transient,
             [](resolver& r) -> erased_ptr {
-                return make_erased_as<TInterface, TImpl>(detail::resolve_dep<Deps>(r)...);
+                return detail::make_with_deps<TInterface, TImpl, Deps...>(r);
             },
             detail::make_dep_infos<Deps...>(), {},
             std::type_index(typeid(TImpl)), loc,
             internal::capture_stacktrace(), "add_transient");
+        return fold_stateless(detail::stateless_factory<TInterface, TImpl, Deps...>());
     }
 
     template <typename TInterface, typename TImpl>
@@ -194,11 +207,12 @@ public:
         static_assert(std::is_same_v<TInterface, TImpl>
                    || std::has_virtual_destructor_v<TInterface>,
             "add_transient<I,T>: I must have a virtual destructor when I != T");
-        return register_single(
+        register_single(
             typeid(TInterface), lifetime_kind::transient,
             [](resolver&) -> erased_ptr { return make_erased_as<TInterface, TImpl>(); },
             {}, std::string(key), std::type_index(typeid(TImpl)), loc,
             internal::capture_stacktrace(), "add_transient");
+        return fold_stateless(detail::stateless_factory<TInterface, TImpl>());
     }
 
     template <typename TInterface, typename TImpl, typename... Deps>
@@ -208,14 +222,201 @@ public:
         static_assert(std::is_same_v<TInterface, TImpl>
                    || std::has_virtual_destructor_v<TInterface>,
             "add_transient<I,T>: I must have a virtual destructor when I != T");
-        return register_single(
+        register_single(
             typeid(TInterface), lifetime_kind::transient,
             [](resolver& r) -> erased_ptr {
-                return make_erased_as<TInterface, TImpl>(detail::resolve_dep<Deps>(r)...);
+                return detail::make_with_deps<TInterface, TImpl, Deps...>(r);
             },
             detail::make_dep_infos<Deps...>(), std::string(key),
             std::type_index(typeid(TImpl)), loc,
             internal::capture_stacktrace(), "add_transient");
+        return fold_stateless(detail::stateless_factory<TInterface, TImpl, Deps...>());
+    }
+
+    // ===============================================================
+    // Refreshable singleton registration (hot-swappable instance)
+    // ===============================================================
+
+    /// Zero-dep refreshable singleton.  Resolved via `acquire<I>()`;
+    /// `refresh<I>()` publishes a replacement built by the same factory.
+    template <typename TInterface, typename TImpl>
+        requires derived_from_base<TImpl, TInterface>
+              && default_constructible<TImpl>
+    registry& add_refreshable(std::source_location loc = std::source_location::current()) {
+        static_assert(std::is_same_v<TInterface, TImpl>
+                   || std::has_virtual_destructor_v<TInterface>,
+            "add_refreshable<I,T>: I must have a virtual destructor when I != T");
+        return register_refreshable(
+            typeid(TInterface),
+            [](resolver&) -> erased_ptr { return make_erased_as<TInterface, TImpl>(); },
+            {}, {}, std::type_index(typeid(TImpl)), loc,
+            internal::capture_stacktrace(), "add_refreshable");
+    }
+
+    /// Refreshable singleton with deps
+    template <typename TInterface, typename TImpl, typename... Deps>
+        requires derived_from_base<TImpl, TInterface>
+              && constructible_from_deps<TImpl, Deps...>
+    registry& add_refreshable(deps_tag<Deps...>, std::source_location loc = std::source_location::current()) {
+        static_assert(std::is_same_v<TInterface, TImpl>
+                   || std::has_virtual_destructor_v<TInterface>,
+            "add_refreshable<I,T>: I must have a virtual destructor when I != T");
+        return register_refreshable(
+            typeid(TInterface),
+            [](resolver& r) -> erased_ptr {
+                return detail::make_with_deps<TInterface, TImpl, Deps...>(r);
+            },
+            detail::make_dep_infos<Deps...>(), {},
+            std::type_index(typeid(TImpl)), loc,
+            internal::capture_stacktrace(), "add_refreshable");
+    }
+
+    /// Keyed zero-dep refreshable singleton
+    template <typename TInterface, typename TImpl>
+        requires derived_from_base<TImpl, TInterface>
+              && default_constructible<TImpl>
+    registry& add_refreshable(std::string_view key, std::source_location loc = std::source_location::current()) {
+        static_assert(std::is_same_v<TInterface, TImpl>
+                   || std::has_virtual_destructor_v<TInterface>,
+            "add_refreshable<I,T>: I must have a virtual destructor when I != T");
+        return register_refreshable(
+            typeid(TInterface),
+            [](resolver&) -> erased_ptr { return make_erased_as<TInterface, TImpl>(); },
+            {}, std::string(key), std::type_index(typeid(TImpl)), loc,
+            internal::capture_stacktrace(), "add_refreshable");
+    }
+
+    /// Keyed refreshable singleton with deps
+    template <typename TInterface, typename TImpl, typename... Deps>
+        requires derived_from_base<TImpl, TInterface>
+              && constructible_from_deps<TImpl, Deps...>
+    registry& add_refreshable(std::string_view key, deps_tag<Deps...>, std::source_location loc = std::source_location::current()) {
+        static_assert(std::is_same_v<TInterface, TImpl>
+                   || std::has_virtual_destructor_v<TInterface>,
+            "add_refreshable<I,T>: I must have a virtual destructor when I != T");
+        return register_refreshable(
+            typeid(TInterface),
+            [](resolver& r) -> erased_ptr {
+                return detail::make_with_deps<TInterface, TImpl, Deps...>(r);
+            },
+            detail::make_dep_infos<Deps...>(), std::string(key),
+            std::type_index(typeid(TImpl)), loc,
+            internal::capture_stacktrace(), "add_refreshable");
+    }
+
+    // ===============================================================
+    // Evictable singleton registration (rebuildable under memory pressure)
+    // ===============================================================
+
+    /// Zero-dep evictable singleton.  Resolved via `acquire<I>()`; the
+    /// instance counts `accounted_size` bytes against the eviction budget
+    /// and is re-created on the next acquire after it has been evicted.
+    template <typename TInterface, typename TImpl>
+        requires derived_from_base<TImpl, TInterface>
+              && default_constructible<TImpl>
+    registry& add_evictable(std::size_t accounted_size,
+                            std::source_location loc = std::source_location::current()) {
+        static_assert(std::is_same_v<TInterface, TImpl>
+                   || std::has_virtual_destructor_v<TInterface>,
+            "add_evictable<I,T>: I must have a virtual destructor when I != T");
+        return register_evictable(
+            typeid(TInterface),
+            [](resolver&) -> erased_ptr { return make_erased_as<TInterface, TImpl>(); },
+            {}, {}, std::type_index(typeid(TImpl)), accounted_size, loc,
+            internal::capture_stacktrace(), "add_evictable");
+    }
+
+    /// Evictable singleton with deps
+    template <typename TInterface, typename TImpl, typename... Deps>
+        requires derived_from_base<TImpl, TInterface>
+              && constructible_from_deps<TImpl, Deps...>
+    registry& add_evictable(std::size_t accounted_size, deps_tag<Deps...>,
+                            std::source_location loc = std::source_location::current()) {
+        static_assert(std::is_same_v<TInterface, TImpl>
+                   || std::has_virtual_destructor_v<TInterface>,
+            "add_evictable<I,T>: I must have a virtual destructor when I != T");
+        return register_evictable(
+            typeid(TInterface),
+            [](resolver& r) -> erased_ptr {
+                return detail::make_with_deps<TInterface, TImpl, Deps...>(r);
+            },
+            detail::make_dep_infos<Deps...>(), {},
+            std::type_index(typeid(TImpl)), accounted_size, loc,
+            internal::capture_stacktrace(), "add_evictable");
+    }
+
+    /// Keyed zero-dep evictable singleton
+    template <typename TInterface, typename TImpl>
+        requires derived_from_base<TImpl, TInterface>
+              && default_constructible<TImpl>
+    registry& add_evictable(std::string_view key, std::size_t accounted_size,
+                            std::source_location loc = std::source_location::current()) {
+        static_assert(std::is_same_v<TInterface, TImpl>
+                   || std::has_virtual_destructor_v<TInterface>,
+            "add_evictable<I,T>: I must have a virtual destructor when I != T");
+        return register_evictable(
+            typeid(TInterface),
+            [](resolver&) -> erased_ptr { return make_erased_as<TInterface, TImpl>(); },
+            {}, std::string(key), std::type_index(typeid(TImpl)), accounted_size, loc,
+            internal::capture_stacktrace(), "add_evictable");
+    }
+
+    /// Keyed evictable singleton with deps
+    template <typename TInterface, typename TImpl, typename... Deps>
+        requires derived_from_base<TImpl, TInterface>
+              && constructible_from_deps<TImpl, Deps...>
+    registry& add_evictable(std::string_view key, std::size_t accounted_size, deps_tag<Deps...>,
+                            std::source_location loc = std::source_location::current()) {
+        static_assert(std::is_same_v<TInterface, TImpl>
+                   || std::has_virtual_destructor_v<TInterface>,
+            "add_evictable<I,T>: I must have a virtual destructor when I != T");
+        return register_evictable(
+            typeid(TInterface),
+            [](resolver& r) -> erased_ptr {
+                return detail::make_with_deps<TInterface, TImpl, Deps...>(r);
+            },
+            detail::make_dep_infos<Deps...>(), std::string(key),
+            std::type_index(typeid(TImpl)), accounted_size, loc,
+            internal::capture_stacktrace(), "add_evictable");
+    }
+
+    // ===============================================================
+    // Singleton families (one instance per runtime key)
+    // ===============================================================
+
+    /// Zero-dep singleton family: `get<I>(key)` creates `TImpl(key)` on
+    /// first use for each distinct key and caches it.  With a non-zero
+    /// `max_instances` the least recently resolved member is evicted past
+    /// the cap, and members are resolved via `acquire<I>(key)` instead.
+    template <typename TInterface, typename TImpl>
+        requires derived_from_base<TImpl, TInterface>
+              && family_constructible_from_deps<TImpl>
+    registry& add_singleton_family(std::size_t max_instances = 0,
+                                   std::source_location loc = std::source_location::current()) {
+        static_assert(std::is_same_v<TInterface, TImpl>
+                   || std::has_virtual_destructor_v<TInterface>,
+            "add_singleton_family<I,T>: I must have a virtual destructor when I != T");
+        return register_family(
+            typeid(TInterface),
+            &detail::make_family_member<TInterface, TImpl>,
+            {}, std::type_index(typeid(TImpl)), max_instances, loc,
+            internal::capture_stacktrace(), "add_singleton_family");
+    }
+
+    /// Singleton family with deps: `TImpl(key, deps...)`
+    template <typename TInterface, typename TImpl, typename... Deps>
+        requires derived_from_base<TImpl, TInterface>
+              && family_constructible_from_deps<TImpl, Deps...>
+    registry& add_singleton_family(deps_tag<Deps...>, std::size_t max_instances = 0,
+                                   std::source_location loc = std::source_location::current()) {
+        static_assert(std::is_same_v<TInterface, TImpl>
+                   || std::has_virtual_destructor_v<TInterface>,
+            "add_singleton_family<I,T>: I must have a virtual destructor when I != T");
+        return register_family(
+            typeid(TInterface),
+            &detail::make_family_member<TInterface, TImpl, Deps...>,
+            detail::make_dep_infos<Deps...>(), std::type_index(typeid(TImpl)),
+            max_instances, loc, internal::capture_stacktrace(), "add_singleton_family");
     }
 
     // ===============================================================
@@ -229,11 +430,12 @@ public:
         static_assert(std::is_same_v<TInterface, TImpl>
                    || std::has_virtual_destructor_v<TInterface>,
             "add_collection<I,T>: I must have a virtual destructor when I != T");
-        return register_collection(
+        register_collection(
             typeid(TInterface), lifetime,
             [](resolver&) -> erased_ptr { return make_erased_as<TInterface, TImpl>(); },
             {}, {}, std::type_index(typeid(TImpl)), loc,
             internal::capture_stacktrace(), "add_collection");
+        return fold_stateless(detail::stateless_factory<TInterface, TImpl>());
     }
 
     template <typename TInterface, typename TImpl, typename... Deps>
@@ -243,14 +445,15 @@ public:
         static_assert(std::is_same_v<TInterface, TImpl>
                    || std::has_virtual_destructor_v<TInterface>,
             "add_collection<I,T>: I must have a virtual destructor when I != T");
-        return register_collection(
+        register_collection(
             typeid(TInterface), lifetime,
             [](resolver& r) -> erased_ptr {
-                return make_erased_as<TInterface, TImpl>(detail::resolve_dep<Deps>(r)...);
+                return detail::make_with_deps<TInterface, TImpl, Deps...>(r);
             },
             detail::make_dep_infos<Deps...>(), {},
             std::type_index(typeid(TImpl)), loc,
             internal::capture_stacktrace(), "add_collection");
+        return fold_stateless(detail::stateless_factory<TInterface, TImpl, Deps...>());
     }
 
     template <typename TInterface, typename TImpl>
@@ -260,11 +463,12 @@ public:
         static_assert(std::is_same_v<TInterface, TImpl>
                    || std::has_virtual_destructor_v<TInterface>,
             "add_collection<I,T>: I must have a virtual destructor when I != T");
-        return register_collection(
+        register_collection(
             typeid(TInterface), lifetime,
             [](resolver&) -> erased_ptr { return make_erased_as<TInterface, TImpl>(); },
             {}, std::string(key), std::type_index(typeid(TImpl)), loc,
             internal::capture_stacktrace(), "add_collection");
+        return fold_stateless(detail::stateless_factory<TInterface, TImpl>());
     }
 
     template <typename TInterface, typename TImpl, typename... Deps>
@@ -274,14 +478,106 @@ public:
         static_assert(std::is_same_v<TInterface, TImpl>
                    || std::has_virtual_destructor_v<TInterface>,
             "add_collection<I,T>: I must have a virtual destructor when I != T");
-        return register_collection(
+        register_collection(
             typeid(TInterface), lifetime,
             [](resolver& r) -> erased_ptr {
-                return make_erased_as<TInterface, TImpl>(detail::resolve_dep<Deps>(r)...);
+                return detail::make_with_deps<TInterface, TImpl, Deps...>(r);
             },
             detail::make_dep_infos<Deps...>(), std::string(key),
             std::type_index(typeid(TImpl)), loc,
             internal::capture_stacktrace(), "add_collection");
+        return fold_stateless(detail::stateless_factory<TInterface, TImpl, Deps...>());
+    }
+
+    // ===============================================================
+    // Variant registration (one of several impls bound by build())
+    // ===============================================================
+
+    /// Candidate implementation for the single-instance slot of I, guarded
+    /// by `when` (CPU features, configuration, environment...).  build()
+    /// evaluates the candidates of a slot once, in registration order, and
+    /// binds the first whose predicate holds; the others are dropped before
+    /// validation and eager creation.  If none holds the slot stays empty.
+    template <typename TInterface, typename TImpl>
+        requires derived_from_base<TImpl, TInterface>
+              && default_constructible<TImpl>
+    registry& add_variant(lifetime_kind lifetime, variant_predicate when, std::source_location loc = std::source_location::current()) {
+        static_assert(std::is_same_v<TInterface, TImpl>
+                   || std::has_virtual_destructor_v<TInterface>,
+            "add_variant<I,T>: I must have a virtual destructor when I != T");
+        return register_variant(
+            typeid(TInterface), lifetime,
+            [](resolver&) -> erased_ptr { return make_erased_as<TInterface, TImpl>(); },
+            {}, {}, std::type_index(typeid(TImpl)), std::move(when), loc,
+            internal::capture_stacktrace(), "add_variant");
+    }
+
+    template <typename TInterface, typename TImpl, typename... Deps>
+        requires derived_from_base<TImpl, TInterface>
+              && constructible_from_deps<TImpl, Deps...>
+    registry& add_variant(lifetime_kind lifetime, variant_predicate when, deps_tag<Deps...>, std::source_location loc = std::source_location::current()) {
+        static_assert(std::is_same_v<TInterface, TImpl>
+                   || std::has_virtual_destructor_v<TInterface>,
+            "add_variant<I,T>: I must have a virtual destructor when I != T");
+        return register_variant(
+            typeid(TInterface), lifetime,
+            [](resolver& r) -> erased_ptr {
+                return detail::make_with_deps<TInterface, TImpl, Deps...>(r);
+            },
+            detail::make_dep_infos<Deps...>(), {}, std::type_index(typeid(TImpl)), std::move(when), loc,
+            internal::capture_stacktrace(), "add_variant");
+    }
+
+    template <typename TInterface, typename TImpl>
+        requires derived_from_base<TImpl, TInterface>
+              && default_constructible<TImpl>
+    registry& add_variant(std::string_view key, lifetime_kind lifetime, variant_predicate when, std::source_location loc = std::source_location::current()) {
+        static_assert(std::is_same_v<TInterface, TImpl>
+                   || std::has_virtual_destructor_v<TInterface>,
+            "add_variant<I,T>: I must have a virtual destructor when I != T");
+        return register_variant(
+            typeid(TInterface), lifetime,
+            [](resolver&) -> erased_ptr { return make_erased_as<TInterface, TImpl>(); },
+            {}, std::string(key), std::type_index(typeid(TImpl)), std::move(when), loc,
+            internal::capture_stacktrace(), "add_variant");
+    }
+
+    template <typename TInterface, typename TImpl, typename... Deps>
+        requires derived_from_base<TImpl, TInterface>
+              && constructible_from_deps<TImpl, Deps...>
+    registry& add_variant(std::string_view key, lifetime_kind lifetime, variant_predicate when, deps_tag<Deps...>, std::source_location loc = std::source_location::current()) {
+        static_assert(std::is_same_v<TInterface, TImpl>
+                   || std::has_virtual_destructor_v<TInterface>,
+            "add_variant<I,T>: I must have a virtual destructor when I != T");
+        return register_variant(
+            typeid(TInterface), lifetime,
+            [](resolver& r) -> erased_ptr {
+                return detail::make_with_deps<TInterface, TImpl, Deps...>(r);
+            },
+            detail::make_dep_infos<Deps...>(), std::string(key), std::type_index(typeid(TImpl)), std::move(when), loc,
+            internal::capture_stacktrace(), "add_variant");
+    }
+
+    // ===============================================================
+    // Plugin registration (factory loaded from a shared object)
+    // ===============================================================
+
+    /// Register a single-instance slot for TInterface whose factory is the
+    /// `symbol` (a plugin_entry_fn) exported by the shared object `library`.
+    /// The library is loaded on the first resolution of this slot and is
+    /// never unloaded.  Deps<> are metadata only: they are validated at
+    /// build() like any other registration, while the entry point resolves
+    /// them itself through the resolver it receives.
+    template <typename TInterface, typename... Deps>
+    registry& add_plugin(lifetime_kind lifetime, std::string_view library,
+                         std::string_view symbol, deps_tag<Deps...> = {},
+                         std::source_location loc = std::source_location::current()) {
+        static_assert(std::has_virtual_destructor_v<TInterface>,
+            "add_plugin<I>: I must have a virtual destructor");
+        return register_plugin(
+            typeid(TInterface), lifetime, std::string(library), std::string(symbol),
+            detail::make_dep_infos<Deps...>(), loc,
+            internal::capture_stacktrace(), "add_plugin");
     }
 
     // ===============================================================
@@ -297,9 +593,7 @@ public:
         return register_forward(
             typeid(TInterface),
             std::type_index(typeid(TTarget)),
-            [](void* raw) -> void* {
-                return static_cast<TInterface*>(static_cast<TTarget*>(raw));
-            },
+            make_forward_cast<TInterface, TTarget>(),
             [](void* p) { delete static_cast<TInterface*>(p); },
             loc, internal::capture_stacktrace(), "forward");
     }
@@ -342,9 +636,10 @@ public:
                     auto ep = inner(r);
                     auto* typed = static_cast<TInterface*>(ep.get());
                     decorated_ptr<TInterface> handle(typed, std::move(ep));
-                    return make_erased_as<TInterface, TDecorator>(
-                        std::move(handle),
-                        detail::resolve_dep<Extra>(r)...);
+                    return std::apply([&handle](auto&&... extra) {
+                        return make_erased_as<TInterface, TDecorator>(
+                            std::move(handle), std::forward<decltype(extra)>(extra)...);
+                    }, r.get_many<Extra...>());
                 };
             },
             detail::make_dep_infos<Extra...>(), loc,
@@ -385,9 +680,10 @@ public:
                     auto ep = inner(r);
                     auto* typed = static_cast<TInterface*>(ep.get());
                     decorated_ptr<TInterface> handle(typed, std::move(ep));
-                    return make_erased_as<TInterface, TDecorator>(
-                        std::move(handle),
-                        detail::resolve_dep<Extra>(r)...);
+                    return std::apply([&handle](auto&&... extra) {
+                        return make_erased_as<TInterface, TDecorator>(
+                            std::move(handle), std::forward<decltype(extra)>(extra)...);
+                    }, r.get_many<Extra...>());
                 };
             },
             detail::make_dep_infos<Extra...>(), loc,
@@ -432,15 +728,231 @@ public:
                     auto ep = inner(r);
                     auto* typed = static_cast<TInterface*>(ep.get());
                     decorated_ptr<TInterface> handle(typed, std::move(ep));
-                    return make_erased_as<TInterface, TDecorator>(
-                        std::move(handle),
-                        detail::resolve_dep<Extra>(r)...);
+                    return std::apply([&handle](auto&&... extra) {
+                        return make_erased_as<TInterface, TDecorator>(
+                            std::move(handle), std::forward<decltype(extra)>(extra)...);
+                    }, r.get_many<Extra...>());
                 };
             },
             detail::make_dep_infos<Extra...>(), loc,
             internal::capture_stacktrace(), "decorate_target");
     }
 
+    // ===============================================================
+    // Toggleable decorators
+    // ===============================================================
+
+    /// Decorate all registrations of I with D, switchable at runtime via
+    /// resolver::set_decorator_enabled<I, D>().  While off, transients are
+    /// built without D and get<I>() returns the undecorated singleton, so
+    /// calls pay nothing.  Toggleable layers are outermost, after all
+    /// ordinary decorators.
+    template <typename TInterface, typename TDecorator>
+        requires derived_from_base<TDecorator, TInterface>
+              && decorator_constructible<TDecorator, TInterface>
+    registry& decorate_toggleable(bool enabled = false,
+                                  std::source_location loc = std::source_location::current()) {
+        static_assert(std::has_virtual_destructor_v<TInterface>,
+            "decorate_toggleable<I,D>: I must have a virtual destructor for decorator registration");
+        return register_toggle(
+            typeid(TInterface),
+            toggle_layer{typeid(TDecorator),
+                [](resolver&, erased_ptr inner) -> erased_ptr {
+                    auto* typed = static_cast<TInterface*>(inner.get());
+                    decorated_ptr<TInterface> handle(typed, std::move(inner));
+                    return make_erased_as<TInterface, TDecorator>(std::move(handle));
+                },
+                enabled},
+            {}, loc, internal::capture_stacktrace(), "decorate_toggleable");
+    }
+
+    /// Toggleable decorator with extra deps (resolved when D is built).
+    template <typename TInterface, typename TDecorator, typename... Extra>
+        requires derived_from_base<TDecorator, TInterface>
+              && decorator_constructible_with_deps<TDecorator, TInterface, Extra...>
+    registry& decorate_toggleable(deps_tag<Extra...>, bool enabled = false,
+                                  std::source_location loc = std::source_location::current()) {
+        static_assert(std::has_virtual_destructor_v<TInterface>,
+            "decorate_toggleable<I,D>: I must have a virtual destructor for decorator registration");
+        return register_toggle(
+            typeid(TInterface),
+            toggle_layer{typeid(TDecorator),
+                [](resolver& r, erased_ptr inner) -> erased_ptr {
+                    auto* typed = static_cast<TInterface*>(inner.get());
+                    decorated_ptr<TInterface> handle(typed, std::move(inner));
+                    return std::apply([&handle](auto&&... extra) {
+                        return make_erased_as<TInterface, TDecorator>(
+                            std::move(handle), std::forward<decltype(extra)>(extra)...);
+                    }, r.get_many<Extra...>());
+                },
+                enabled},
+            detail::make_dep_infos<Extra...>(), loc,
+            internal::capture_stacktrace(), "decorate_toggleable");
+    }
+
+    // ===============================================================
+    // Static decorator chains
+    // ===============================================================
+
+    /// Build every registration of I bound to TImpl as one
+    /// `static_chain<TImpl, Layers...>` object instead of TImpl, so the
+    /// layers call each other without virtual dispatch or indirection.
+    /// Layers are `template <class Base> class L : public Base` mixins that
+    /// inherit TImpl's constructor; TImpl must not be `final`.  Applied by
+    /// build() before ordinary decorators, which still wrap the result.
+    /// Usage: registry.decorate_static<IFoo, FooImpl, Metrics, Retry>()
+    template <typename TInterface, typename TImpl, template <typename> class... Layers>
+        requires derived_from_base<TImpl, TInterface>
+              && default_constructible<static_chain<TImpl, Layers...>>
+    registry& decorate_static(std::source_location loc = std::source_location::current()) {
+        using chain = static_chain<TImpl, Layers...>;
+        static_assert(sizeof...(Layers) > 0, "decorate_static<I,T,L...>: at least one layer is required");
+        static_assert(derived_from_base<chain, TImpl>,
+            "decorate_static<I,T,L...>: every layer must derive from its template argument");
+        return register_static_chain(
+            typeid(TInterface), typeid(TImpl),
+            [](resolver&) -> erased_ptr { return make_erased_as<TInterface, chain>(); },
+            {}, loc, internal::capture_stacktrace(), "decorate_static");
+    }
+
+    /// Same, for a TImpl registered with `deps<Deps...>`; the dependency
+    /// list must match the registration's, since the chain is built from
+    /// the same constructor arguments.
+    template <typename TInterface, typename TImpl, template <typename> class... Layers,
+              typename... Deps>
+        requires derived_from_base<TImpl, TInterface>
+              && constructible_from_deps<static_chain<TImpl, Layers...>, Deps...>
+    registry& decorate_static(deps_tag<Deps...>,
+                              std::source_location loc = std::source_location::current()) {
+        using chain = static_chain<TImpl, Layers...>;
+        static_assert(sizeof...(Layers) > 0, "decorate_static<I,T,L...>: at least one layer is required");
+        static_assert(derived_from_base<chain, TImpl>,
+            "decorate_static<I,T,L...>: every layer must derive from its template argument");
+        return register_static_chain(
+            typeid(TInterface), typeid(TImpl),
+            [](resolver& r) -> erased_ptr {
+                return detail::make_with_deps<TInterface, chain, Deps...>(r);
+            },
+            detail::make_dep_infos<Deps...>(), loc,
+            internal::capture_stacktrace(), "decorate_static");
+    }
+
+    // ===============================================================
+    // Exit policy
+    // ===============================================================
+
+    /// Set the teardown behaviour of all singleton registrations of I.
+    /// Usage: registry.set_exit_policy<ICache>(exit_policy::leak)
+    template <typename TInterface>
+    registry& set_exit_policy(exit_policy policy, std::source_location loc = std::source_location::current()) {
+        return register_policy(
+            typeid(TInterface), std::nullopt,
+            [policy](descriptor& d) { d.on_exit = policy; },
+            loc, "set_exit_policy");
+    }
+
+    /// Set the teardown behaviour of a specific impl TTarget of I.
+    /// Usage: registry.set_exit_policy_target<ISink, FileSink>(exit_policy::destroy)
+    template <typename TInterface, typename TTarget>
+        requires derived_from_base<TTarget, TInterface>
+    registry& set_exit_policy_target(exit_policy policy, std::source_location loc = std::source_location::current()) {
+        return register_policy(
+            typeid(TInterface), std::type_index(typeid(TTarget)),
+            [policy](descriptor& d) { d.on_exit = policy; },
+            loc, "set_exit_policy_target");
+    }
+
+    // ===============================================================
+    // Merge
+    // ===============================================================
+
+    /// Append every registration of `other` (e.g. a module registry filled
+    /// on another thread) after this registry's own, leaving `other` empty.
+    /// Single-instance slots stay unique: a slot occupied in both throws
+    /// duplicate_registration and leaves both registries unchanged.
+    /// Collections keep merge order; forwards and decorators of all merged
+    /// registries are applied over the combined set at build().
+    registry& merge(registry&& other, std::source_location loc = std::source_location::current());
+
+    // ===============================================================
+    // Fork policy
+    // ===============================================================
+
+    /// Set the post-fork behaviour of all singleton registrations of I.
+    /// Usage: registry.set_fork_policy<IWorkerPool>(fork_policy::reinitialize)
+    template <typename TInterface>
+    registry& set_fork_policy(fork_policy policy, std::source_location loc = std::source_location::current()) {
+        return register_policy(
+            typeid(TInterface), std::nullopt,
+            [policy](descriptor& d) { d.on_fork = policy; },
+            loc, "set_fork_policy");
+    }
+
+    /// Set the post-fork behaviour of the registrations of I whose impl is TTarget.
+    /// Usage: registry.set_fork_policy_target<ISink, FileSink>(fork_policy::reinitialize)
+    template <typename TInterface, typename TTarget>
+        requires derived_from_base<TTarget, TInterface>
+    registry& set_fork_policy_target(fork_policy policy, std::source_location loc = std::source_location::current()) {
+        return register_policy(
+            typeid(TInterface), std::type_index(typeid(TTarget)),
+            [policy](descriptor& d) { d.on_fork = policy; },
+            loc, "set_fork_policy_target");
+    }
+
+    // ===============================================================
+    // Startup phases
+    // ===============================================================
+
+    /// Construct the singleton registrations of I in a named startup phase
+    /// (one of build_options::startup_phases).
+    /// Usage: registry.set_startup_phase<IHealthCheck>("critical")
+    template <typename TInterface>
+    registry& set_startup_phase(std::string_view phase, std::source_location loc = std::source_location::current()) {
+        return register_policy(
+            typeid(TInterface), std::nullopt,
+            [p = std::string(phase)](descriptor& d) { d.startup_phase = p; },
+            loc, "set_startup_phase");
+    }
+
+    /// Assign the registrations of I whose impl is TTarget to a startup phase.
+    /// Usage: registry.set_startup_phase_target<ICache, DiskCache>("background")
+    template <typename TInterface, typename TTarget>
+        requires derived_from_base<TTarget, TInterface>
+    registry& set_startup_phase_target(std::string_view phase, std::source_location loc = std::source_location::current()) {
+        return register_policy(
+            typeid(TInterface), std::type_index(typeid(TTarget)),
+            [p = std::string(phase)](descriptor& d) { d.startup_phase = p; },
+            loc, "set_startup_phase_target");
+    }
+
+    // ===============================================================
+    // Construction deadlines
+    // ===============================================================
+
+    /// Watchdog thresholds for the factories of every registration of I,
+    /// overriding build_options::factory_deadline field by field.
+    /// Usage: registry.set_construction_deadline<IResolver>({.soft = 200ms, .hard = 5s})
+    template <typename TInterface>
+    registry& set_construction_deadline(construction_deadline deadline,
+                                        std::source_location loc = std::source_location::current()) {
+        return register_policy(
+            typeid(TInterface), std::nullopt,
+            [deadline](descriptor& d) { d.deadline = deadline; },
+            loc, "set_construction_deadline");
+    }
+
+    /// Watchdog thresholds for the registrations of I whose impl is TTarget.
+    /// Usage: registry.set_construction_deadline_target<ICache, DiskCache>({.hard = 30s})
+    template <typename TInterface, typename TTarget>
+        requires derived_from_base<TTarget, TInterface>
+    registry& set_construction_deadline_target(construction_deadline deadline,
+                                               std::source_location loc = std::source_location::current()) {
+        return register_policy(
+            typeid(TInterface), std::type_index(typeid(TTarget)),
+            [deadline](descriptor& d) { d.deadline = deadline; },
+            loc, "set_construction_deadline_target");
+    }
+
     // ===============================================================
     // Build
     // ===============================================================
@@ -448,6 +960,12 @@ public:
     std::shared_ptr<resolver> build(build_options options = {},
                                      std::source_location loc = std::source_location::current());
 
+    /// Expand, decorate and validate once; the returned graph can then
+    /// `instantiate()` any number of independent resolvers.  Like build(),
+    /// compile() consumes the registry and may only be called once.
+    std::shared_ptr<const compiled_graph> compile(build_options options = {},
+                                                  std::source_location loc = std::source_location::current());
+
     const std::vector<descriptor>& descriptors() const;
 
 private:
@@ -471,6 +989,23 @@ private:
                                   std::any stacktrace,
                                   std::string api_name);
 
+    // Mark the transient just registered as stateless (no-op for nullptr)
+    registry& fold_stateless(stateless_fn make) noexcept;
+
+    // TTarget* → TInterface*: a memoized offset for non-virtual bases,
+    // a plain function pointer otherwise
+    template <typename TInterface, typename TTarget>
+    static forward_cast_fn make_forward_cast() noexcept {
+        forward_cast_fn::function_ptr cast = [](void* raw) -> void* {
+            return static_cast<TInterface*>(static_cast<TTarget*>(raw));
+        };
+        if constexpr (non_virtual_base_of<TTarget, TInterface>) {
+            return forward_cast_fn::constant_offset(cast);
+        } else {
+            return forward_cast_fn::function(cast);
+        }
+    }
+
     // Forward registration
     registry& register_forward(std::type_index interface_type,
                                std::type_index target_type,
@@ -480,6 +1015,54 @@ private:
                                std::any stacktrace,
                                std::string api_name);
 
+    // Refreshable registration: singleton slot with a swappable instance
+    registry& register_refreshable(std::type_index type,
+                                   factory_fn factory,
+                                   std::vector<dependency_info> deps,
+                                   std::string key,
+                                   std::optional<std::type_index> impl_type,
+                                   std::source_location loc,
+                                   std::any stacktrace,
+                                   std::string api_name);
+
+    // Evictable registration: singleton slot the resolver may drop and rebuild
+    registry& register_evictable(std::type_index type,
+                                 factory_fn factory,
+                                 std::vector<dependency_info> deps,
+                                 std::string key,
+                                 std::optional<std::type_index> impl_type,
+                                 std::size_t accounted_size,
+                                 std::source_location loc,
+                                 std::any stacktrace,
+                                 std::string api_name);
+
+    // Family registration: non-keyed singleton slot of per-key instances
+    registry& register_family(std::type_index type,
+                              factory_fn factory,
+                              std::vector<dependency_info> deps,
+                              std::optional<std::type_index> impl_type,
+                              std::size_t max_instances,
+                              std::source_location loc,
+                              std::any stacktrace,
+                              std::string api_name);
+
+    // Variant registration: candidate for a single-instance slot
+    registry& register_variant(std::type_index type, lifetime_kind lifetime,
+                               factory_fn factory, std::vector<dependency_info> deps,
+                               std::string key, std::optional<std::type_index> impl_type,
+                               variant_predicate when,
+                               std::source_location loc,
+                               std::any stacktrace,
+                               std::string api_name);
+
+    // Plugin registration: single-instance slot with a lazily loaded factory
+    registry& register_plugin(std::type_index type, lifetime_kind lifetime,
+                              std::string library, std::string symbol,
+                              std::vector<dependency_info> deps,
+                              std::source_location loc,
+                              std::any stacktrace,
+                              std::string api_name);
+
     using decorator_wrapper = std::function<factory_fn(factory_fn)>;
 
     registry& register_decorator(std::type_index interface_type,
@@ -490,6 +1073,37 @@ private:
                                  std::any stacktrace,
                                  std::string api_name);
 
+    registry& register_toggle(std::type_index interface_type,
+                              toggle_layer layer,
+                              std::vector<dependency_info> extra_deps,
+                              std::source_location loc,
+                              std::any stacktrace,
+                              std::string api_name);
+
+    // Static chain: replaces the factory of matching (I, TImpl) registrations
+    registry& register_static_chain(std::type_index interface_type,
+                                    std::type_index impl_type,
+                                    factory_fn factory,
+                                    std::vector<dependency_info> deps,
+                                    std::source_location loc,
+                                    std::any stacktrace,
+                                    std::string api_name);
+
+    using policy_fn = std::function<void(descriptor&)>;
+
+    // Per-registration policy (applied to matching descriptors at build)
+    registry& register_policy(std::type_index interface_type,
+                              std::optional<std::type_index> target_impl,
+                              policy_fn apply,
+                              std::source_location loc,
+                              std::string api_name);
+
+    // Child-resolver overrides: expand forwards, apply decorators and
+    // policies, then hand the descriptors over (consumes the registry).
+    friend class resolver;
+    std::vector<descriptor> compile_overlay(std::size_t index_base,
+                                            std::source_location loc);
+
     struct Impl;
     std::unique_ptr<Impl> impl_;
 };
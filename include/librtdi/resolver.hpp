@@ -3,16 +3,52 @@
 #include "export.hpp"
 #include "descriptor.hpp"
 #include "exceptions.hpp"
+#include "refreshable.hpp"
+#include "type_traits.hpp"
 
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <future>
 #include <memory>
+#include <source_location>
+#include <stop_token>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <typeindex>
+#include <utility>
 #include <vector>
 
 namespace librtdi {
 
-class LIBRTDI_EXPORT resolver {
+namespace internal {
+struct resolver_graph;
+} // namespace internal
+
+namespace detail {
+
+/// dependency_info for one `deps<...>` / `get_many<...>` entry.
+template <typename D>
+dependency_info dep_info_of() {
+    dependency_info info{
+        std::type_index(typeid(typename dep_traits<D>::interface_type)),
+        dep_traits<D>::is_collection,
+        dep_traits<D>::is_transient,
+        is_refreshable_dep_v<D>
+    };
+    if constexpr (is_exact_dep_v<D>) {
+        info.exact_impl = std::type_index(typeid(typename dep_traits<D>::exact_type));
+    }
+    if constexpr (!dep_key_v<D>.empty()) {
+        info.key = std::string(dep_key_v<D>);
+    }
+    return info;
+}
+
+} // namespace detail
+
+class LIBRTDI_EXPORT resolver : public std::enable_shared_from_this<resolver> {
 public:
     ~resolver();
 
@@ -58,30 +94,93 @@ public:
     /// Get all singleton collection items for T.
     template <typename T>
     std::vector<T*> get_all() {
-        auto raw = get_collection_impl(typeid(T), std::string{});
-        std::vector<T*> result;
-        result.reserve(raw.size());
-        for (void* p : raw) result.push_back(static_cast<T*>(p));
-        return result;
+        return cast_all<T>(get_collection_impl(typeid(T), std::string{}, nullptr));
+    }
+
+    /// Get all singleton collection items for T; members not created yet
+    /// and not depending on each other are constructed in parallel on
+    /// `executor`.  The result keeps registration order.
+    template <typename T>
+    std::vector<T*> get_all(const task_executor& executor) {
+        return cast_all<T>(get_collection_impl(typeid(T), std::string{}, &executor));
     }
 
     /// Create all transient collection items for T.
     template <typename T>
     std::vector<std::unique_ptr<T>> create_all() {
-        auto raw = create_collection_impl(typeid(T), std::string{});
-        std::vector<std::unique_ptr<T>> result;
-        result.reserve(raw.size());
-        for (auto& ep : raw) {
-            result.push_back(std::unique_ptr<T>(static_cast<T*>(ep.release())));
+        return own_all<T>(create_collection_impl(typeid(T), std::string{}, nullptr));
+    }
+
+    /// Create all transient collection items for T in parallel on `executor`.
+    template <typename T>
+    std::vector<std::unique_ptr<T>> create_all(const task_executor& executor) {
+        return own_all<T>(create_collection_impl(typeid(T), std::string{}, &executor));
+    }
+
+    // ---------------------------------------------------------------
+    // Batch resolution
+    // ---------------------------------------------------------------
+
+    /// Resolve several dependencies in one call, e.g.
+    /// `get_many<IA, transient<IB>, collection<IC>>()`.  Each element is
+    /// resolved exactly as a `deps<Ds...>` constructor argument would be.
+    /// The slot lookup for a type list is computed once per resolver and
+    /// cached.  Singleton and singleton-collection slots are resolved first,
+    /// in declaration order, under one acquisition of the resolver lock
+    /// (none if there are none); transient slots are built after it.
+    /// Throws not_found for an unregistered single-instance dependency,
+    /// before anything is resolved.
+    template <typename... Ds>
+    std::tuple<inject_type_t<Ds>...> get_many() {
+        if constexpr (sizeof...(Ds) == 0) {
+            return {};
+        } else {
+            // Both built once per instantiation rather than on every call
+            static const dependency_info infos[] = { detail::dep_info_of<Ds>()... };
+            static const std::size_t plan_id = next_batch_plan_id();
+            std::array<batch_slot, sizeof...(Ds)> slots;
+            resolve_batch_impl(plan_id, infos, slots.data(), sizeof...(Ds));
+            return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                return std::tuple<inject_type_t<Ds>...>(take_batch_slot<Ds>(slots[Is])...);
+            }(std::index_sequence_for<Ds...>{});
         }
-        return result;
+    }
+
+    // ---------------------------------------------------------------
+    // Exact-type resolution
+    // ---------------------------------------------------------------
+
+    /// Get the singleton bound to I as its concrete, `final` implementation
+    /// type, so calls through the result need no virtual dispatch.  Throws
+    /// not_found if I is not registered, and di_error if the slot is not an
+    /// undecorated TImpl.
+    template <typename I, typename TImpl>
+        requires exact_impl_of<TImpl, I>
+    TImpl& get_exact() {
+        void* p = get_exact_impl(typeid(I), std::string{}, typeid(TImpl));
+        if (!p) throw not_found(typeid(I), std::string_view{},
+                                slot_hint(typeid(I), {}, "get_exact<I, TImpl>()"));
+        return *static_cast<TImpl*>(static_cast<I*>(p));
+    }
+
+    /// Keyed variant of get_exact<I, TImpl>().
+    template <typename I, typename TImpl>
+        requires exact_impl_of<TImpl, I>
+    TImpl& get_exact(std::string_view key) {
+        void* p = get_exact_impl(typeid(I), std::string(key), typeid(TImpl));
+        if (!p) throw not_found(typeid(I), key,
+                                slot_hint(typeid(I), std::string(key), "get_exact<I, TImpl>(key)"));
+        return *static_cast<TImpl*>(static_cast<I*>(p));
     }
 
     // ---------------------------------------------------------------
     // Keyed singleton resolution
     // ---------------------------------------------------------------
 
-    /// Get a keyed singleton by interface.  Throws not_found if not registered.
+    /// Get a keyed singleton by interface.  A key with no registration of
+    /// its own resolves to the member of T's singleton family for that key
+    /// (registry::add_singleton_family), created on first use.  Throws
+    /// not_found if neither is registered.
     template <typename T>
     T& get(std::string_view key) {
         void* p = get_singleton_impl(typeid(T), std::string(key));
@@ -116,25 +215,175 @@ public:
     /// Get all keyed singleton collection items for T.
     template <typename T>
     std::vector<T*> get_all(std::string_view key) {
-        auto raw = get_collection_impl(typeid(T), std::string(key));
-        std::vector<T*> result;
-        result.reserve(raw.size());
-        for (void* p : raw) result.push_back(static_cast<T*>(p));
-        return result;
+        return cast_all<T>(get_collection_impl(typeid(T), std::string(key), nullptr));
+    }
+
+    template <typename T>
+    std::vector<T*> get_all(std::string_view key, const task_executor& executor) {
+        return cast_all<T>(get_collection_impl(typeid(T), std::string(key), &executor));
     }
 
     /// Create all keyed transient collection items for T.
     template <typename T>
     std::vector<std::unique_ptr<T>> create_all(std::string_view key) {
-        auto raw = create_collection_impl(typeid(T), std::string(key));
-        std::vector<std::unique_ptr<T>> result;
-        result.reserve(raw.size());
-        for (auto& ep : raw) {
-            result.push_back(std::unique_ptr<T>(static_cast<T*>(ep.release())));
-        }
-        return result;
+        return own_all<T>(create_collection_impl(typeid(T), std::string(key), nullptr));
+    }
+
+    template <typename T>
+    std::vector<std::unique_ptr<T>> create_all(std::string_view key, const task_executor& executor) {
+        return own_all<T>(create_collection_impl(typeid(T), std::string(key), &executor));
+    }
+
+    // ---------------------------------------------------------------
+    // Refreshable singletons (registry::add_refreshable)
+    // ---------------------------------------------------------------
+
+    /// Guard over the currently published instance of a refreshable or
+    /// evictable slot, or of a singleton-family member (keyed overload);
+    /// creates the instance on demand (also after it was evicted).  Throws
+    /// not_found if not registered, di_error if the slot is a plain
+    /// singleton.
+    template <typename T>
+    read_guard<T> acquire() {
+        auto p = acquire_refreshable_impl(typeid(T), std::string{});
+        if (!p) throw not_found(typeid(T), std::string_view{},
+                                slot_hint(typeid(T), {}, "acquire<T>()"));
+        return read_guard<T>(std::move(p));
+    }
+
+    template <typename T>
+    read_guard<T> acquire(std::string_view key) {
+        auto p = acquire_refreshable_impl(typeid(T), std::string(key));
+        if (!p) throw not_found(typeid(T), key,
+                                slot_hint(typeid(T), std::string(key), "acquire<T>(key)"));
+        return read_guard<T>(std::move(p));
+    }
+
+    /// Build a replacement through the slot's factory and publish it.
+    /// Readers are never blocked; guards over the previous instance stay
+    /// valid and it is destroyed when the last one is released.  on_refresh
+    /// subscribers are called after publication.
+    template <typename T>
+    void refresh() {
+        if (!refresh_refreshable_impl(typeid(T), std::string{}))
+            throw not_found(typeid(T), std::string_view{},
+                            slot_hint(typeid(T), {}, "refresh<T>()"));
+    }
+
+    template <typename T>
+    void refresh(std::string_view key) {
+        if (!refresh_refreshable_impl(typeid(T), std::string(key)))
+            throw not_found(typeid(T), key,
+                            slot_hint(typeid(T), std::string(key), "refresh<T>(key)"));
+    }
+
+    /// Call `callback` with each newly published instance of T.  Callbacks
+    /// run on the refreshing thread and must not refresh T themselves.
+    template <typename T>
+    [[nodiscard]] refresh_subscription on_refresh(std::function<void(T&)> callback) {
+        return on_refresh_impl<T>(std::string{}, std::move(callback));
     }
 
+    template <typename T>
+    [[nodiscard]] refresh_subscription on_refresh(std::string_view key,
+                                                  std::function<void(T&)> callback) {
+        return on_refresh_impl<T>(std::string(key), std::move(callback));
+    }
+
+    // ---------------------------------------------------------------
+    // Evictable singletons (registry::add_evictable)
+    // ---------------------------------------------------------------
+
+    /// Memory-pressure hook: evict resident evictable singletons owned by
+    /// this resolver, least recently acquired first, until their accounted
+    /// size is at most `target_bytes`.  Returns the accounted bytes
+    /// released.  An evicted instance still pinned by a read_guard is
+    /// destroyed when its last guard is released.
+    std::size_t trim(std::size_t target_bytes = 0);
+
+    /// Accounted size of the evictable singletons currently resident in
+    /// this resolver.
+    std::size_t evictable_bytes() const noexcept;
+
+    // ---------------------------------------------------------------
+    // Toggleable decorators (registry::decorate_toggleable)
+    // ---------------------------------------------------------------
+
+    /// Switch decorator D on or off for every registration of I in this
+    /// resolver.  Transients created afterwards follow the new state;
+    /// singletons switch the instance get<I>() returns, building D on
+    /// first enable.  References obtained earlier are not redirected.
+    /// Returns the number of registrations affected.
+    template <typename I, typename D>
+    std::size_t set_decorator_enabled(bool enabled) {
+        return set_decorator_enabled_impl(typeid(I), nullptr, typeid(D), enabled);
+    }
+
+    /// Same, for the registrations of I under `key` only.
+    template <typename I, typename D>
+    std::size_t set_decorator_enabled(std::string_view key, bool enabled) {
+        const std::string k(key);
+        return set_decorator_enabled_impl(typeid(I), &k, typeid(D), enabled);
+    }
+
+    // ---------------------------------------------------------------
+    // Startup phases
+    // ---------------------------------------------------------------
+
+    /// Readiness of a startup phase (build_options::startup_phases): ready
+    /// once the phase's singletons and their dependencies are built, or
+    /// holding the exception that stopped startup at this or an earlier
+    /// phase.  Throws di_error if `phase` was not declared.
+    std::shared_future<void> phase_ready(std::string_view phase) const;
+
+    // ---------------------------------------------------------------
+    // Construction deadlines
+    // ---------------------------------------------------------------
+
+    /// For use inside a constructor being resolved: stop token of the
+    /// construction it belongs to, requested by the watchdog when a factory
+    /// call in it passes its hard construction_deadline.  Pass it on to
+    /// asynchronous work the constructor waits for.  stop_possible() is
+    /// false outside a watched resolution.
+    static std::stop_token construction_stop_token() noexcept;
+
+    // ---------------------------------------------------------------
+    // Child resolvers
+    // ---------------------------------------------------------------
+
+    /// Create a child resolver whose slots registered in `overrides` replace
+    /// this resolver's slots of the same (type, key, lifetime, collection).
+    /// Every other slot falls through to this resolver; singletons that do
+    /// not (transitively) depend on a replaced slot are shared with it,
+    /// the rest are re-created in the child.  Only the overriding
+    /// registrations are validated.  The child keeps this resolver alive.
+    std::shared_ptr<resolver> create_child(registry overrides,
+                                           build_options options = {},
+                                           std::source_location loc = std::source_location::current());
+
+    // ---------------------------------------------------------------
+    // fork() support (pre-fork worker servers)
+    // ---------------------------------------------------------------
+
+    /// Call right before fork(): waits for in-flight singleton creation,
+    /// refreshes and evictions and holds every resolver lock across the
+    /// fork.  Must be paired with after_fork_parent() in the parent and
+    /// after_fork_child() in the child (e.g. via pthread_atfork).
+    void prepare_fork();
+
+    /// Call in the parent after fork(): releases the locks taken by prepare_fork().
+    void after_fork_parent();
+
+    /// Call in the child after fork(): resets the lock state, then drops
+    /// every created singleton with fork_policy::reinitialize and every
+    /// created singleton that (transitively) depends on one.  Dropped
+    /// instances are leaked untouched unless
+    /// build_options::destroy_stale_on_fork is set.  Startup then runs
+    /// again as in build(): eager singletons and startup phases are
+    /// rebuilt and phase_ready() returns fresh futures; the rest are
+    /// re-created on next use.
+    void after_fork_child();
+
     // ---------------------------------------------------------------
     // Internal: resolve a descriptor by index (used by forward)
     // ---------------------------------------------------------------
@@ -144,18 +393,132 @@ public:
 
 private:
     friend class registry;
+    friend class compiled_graph;
 
     struct impl;
 
-    static std::shared_ptr<resolver> create(std::vector<descriptor> descriptors);
+    static std::shared_ptr<resolver> create(std::shared_ptr<const internal::resolver_graph> graph,
+                                            std::shared_ptr<resolver> parent = nullptr);
 
     explicit resolver(std::unique_ptr<impl> impl);
 
     // Non-template core implementations
     void* get_singleton_impl(std::type_index type, const std::string& key);
+    void* get_exact_impl(std::type_index type, const std::string& key,
+                         std::type_index impl_type);
     erased_ptr create_transient_impl(std::type_index type, const std::string& key);
-    std::vector<void*> get_collection_impl(std::type_index type, const std::string& key);
-    std::vector<erased_ptr> create_collection_impl(std::type_index type, const std::string& key);
+    std::vector<void*> get_collection_impl(std::type_index type, const std::string& key,
+                                           const task_executor* executor);
+    std::vector<erased_ptr> create_collection_impl(std::type_index type, const std::string& key,
+                                                   const task_executor* executor);
+
+    const task_executor* pick_executor(const task_executor* executor) const noexcept;
+    void create_members_in_parallel(const std::vector<std::size_t>& members,
+                                    const task_executor& executor);
+
+    template <typename T>
+    static std::vector<T*> cast_all(std::vector<void*> raw) {
+        std::vector<T*> result;
+        result.reserve(raw.size());
+        for (void* p : raw) result.push_back(static_cast<T*>(p));
+        return result;
+    }
+
+    template <typename T>
+    static std::vector<std::unique_ptr<T>> own_all(std::vector<erased_ptr> raw) {
+        std::vector<std::unique_ptr<T>> result;
+        result.reserve(raw.size());
+        for (auto& ep : raw) {
+            result.push_back(std::unique_ptr<T>(static_cast<T*>(ep.release())));
+        }
+        return result;
+    }
+
+    // get_many<Ds...>() support
+    struct batch_slot {
+        void* single = nullptr;
+        erased_ptr owned;
+        std::vector<void*> many;
+        std::vector<erased_ptr> owned_many;
+    };
+
+    /// Dense process-wide id of a get_many<Ds...>() instantiation, the
+    /// index of its plan in every resolver.
+    static std::size_t next_batch_plan_id() noexcept;
+    void resolve_batch_impl(std::size_t plan_id, const dependency_info* deps,
+                            batch_slot* out, std::size_t count);
+    void* resolve_singleton_locked(std::size_t idx);
+
+    template <typename D>
+    inject_type_t<D> take_batch_slot(batch_slot& slot) {
+        using traits = dep_traits<D>;
+        using I = typename traits::interface_type;
+
+        if constexpr (is_refreshable_dep_v<D>) {
+            return refreshable_ref<I>(*this);
+        } else if constexpr (is_exact_dep_v<D>) {
+            using TImpl = typename traits::exact_type;
+            return *static_cast<TImpl*>(static_cast<I*>(slot.single));
+        } else if constexpr (traits::is_collection && traits::is_transient) {
+            std::vector<std::unique_ptr<I>> result;
+            result.reserve(slot.owned_many.size());
+            for (auto& ep : slot.owned_many) {
+                result.push_back(std::unique_ptr<I>(static_cast<I*>(ep.release())));
+            }
+            return result;
+        } else if constexpr (traits::is_collection) {
+            std::vector<I*> result;
+            result.reserve(slot.many.size());
+            for (void* p : slot.many) result.push_back(static_cast<I*>(p));
+            return result;
+        } else if constexpr (traits::is_transient) {
+            return std::unique_ptr<I>(static_cast<I*>(slot.owned.release()));
+        } else {
+            return *static_cast<I*>(slot.single);
+        }
+    }
+
+    std::shared_ptr<void> acquire_refreshable_impl(std::type_index type, const std::string& key);
+    std::shared_ptr<void> acquire_refreshable_by_index(std::size_t idx);
+    bool refresh_refreshable_impl(std::type_index type, const std::string& key);
+    void refresh_refreshable_by_index(std::size_t idx);
+    std::shared_ptr<void> resolve_family_by_index(std::size_t idx, const std::string& key);
+    void* resolve_family_member(std::size_t idx, const std::string& key);
+    std::size_t trim_evictable(std::size_t target_bytes, const void* keep);
+    std::size_t set_decorator_enabled_impl(std::type_index type, const std::string* key,
+                                           std::type_index decorator, bool enabled);
+    refresh_subscription subscribe_refresh_impl(std::type_index type, const std::string& key,
+                                                std::function<void(void*)> callback);
+
+    template <typename T>
+    refresh_subscription on_refresh_impl(std::string key, std::function<void(T&)> callback) {
+        return subscribe_refresh_impl(typeid(T), key,
+            [cb = std::move(callback)](void* p) { cb(*static_cast<T*>(p)); });
+    }
+
+    /// Run the startup phases, or create_eager_singletons() for an eager
+    /// resolver without phases.  With a hard construction deadline, runs
+    /// them on a thread owned by the resolver so that a timeout can fail
+    /// build() while the factory is still stuck.
+    void start_up();
+
+    /// Build phase after phase, fulfilling the phase futures in order.
+    void run_startup_phases();
+
+    /// Startup was failed by a hard timeout; the startup task stops early.
+    bool startup_abandoned() const noexcept;
+
+    /// Build one singleton of a startup phase without holding the cache
+    /// lock across its factory.
+    void build_startup_singleton(std::size_t idx);
+
+    /// Create all singletons (and publish refreshables) of an eager resolver.
+    void create_eager_singletons();
+
+    /// create_eager_singletons() for collect_eager_errors: attempts every
+    /// singleton whose dependencies succeeded, then throws
+    /// eager_construction_error if any failed.
+    void create_eager_singletons_collecting();
 
     /// Build a diagnostic hint when a type is not found in the expected slot.
     std::string slot_hint(std::type_index type, const std::string& key,
@@ -164,4 +527,9 @@ private:
     std::shared_ptr<impl> impl_;
 };
 
+template <typename T>
+read_guard<T> refreshable_ref<T>::acquire() const {
+    return resolver_->acquire<T>();
+}
+
 } // namespace librtdi
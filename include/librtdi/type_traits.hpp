@@ -1,8 +1,11 @@
 #pragma once
 
 #include "decorated_ptr.hpp"
+#include "refreshable.hpp"
 
+#include <cstddef>
 #include <memory>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
 #include <vector>
@@ -17,10 +20,24 @@ namespace librtdi {
 template <typename TDerived, typename TBase>
 concept derived_from_base = std::is_base_of_v<TBase, TDerived>;
 
+/// TBase is reached from TDerived without a virtual base, so a TDerived* →
+/// TBase* conversion is the same constant offset for every object.
+template <typename TDerived, typename TBase>
+concept non_virtual_base_of = derived_from_base<TDerived, TBase>
+    && requires(TBase* p) { static_cast<TDerived*>(p); };
+
 /// T is default-constructible (for zero-dependency registrations).
 template <typename T>
 concept default_constructible = std::is_default_constructible_v<T>;
 
+/// T holds no state of its own: an empty class, or a polymorphic class
+/// whose only member is its vtable pointer.  Its default constructor must
+/// not throw, so a zero-dependency transient T can be built without a
+/// factory frame (registry::add_transient).
+template <typename T>
+concept stateless_impl = std::is_nothrow_default_constructible_v<T>
+    && (std::is_empty_v<T> || (std::is_polymorphic_v<T> && sizeof(T) == sizeof(void*)));
+
 // ---------------------------------------------------------------
 // Dependency wrapper tag types
 // ---------------------------------------------------------------
@@ -39,6 +56,48 @@ struct singleton { using type = T; };
 template <typename T>
 struct collection { using type = T; };
 
+/// Marks a dependency on a refreshable slot.  Constructor receives
+/// `refreshable_ref<T>`; call `acquire()` for the current instance.
+template <typename T>
+struct refreshable { using type = T; };
+
+/// Marks a dependency on an evictable slot.  Same handle as
+/// `refreshable<T>`: each `acquire()` pins the resident instance,
+/// re-creating it if it was evicted.
+template <typename T>
+using evictable = refreshable<T>;
+
+/// Marks a dependency on the exact implementation bound to singleton `I`.
+/// Constructor receives `TImpl&`, so calls through it can be devirtualized.
+/// `TImpl` must be `final`; the binding is checked when the registry is built.
+template <typename I, typename TImpl>
+struct exact { using type = I; };
+
+/// String literal usable as a template argument (`keyed<T, "name">`).
+template <std::size_t N>
+struct fixed_string {
+    char value[N]{};
+
+    constexpr fixed_string(const char (&s)[N]) {
+        for (std::size_t i = 0; i < N; ++i) value[i] = s[i];
+    }
+
+    constexpr std::string_view view() const noexcept { return {value, N - 1}; }
+};
+
+/// Marks a dependency on the registration of `D` under `Key`, e.g.
+/// `keyed<IDb, "replica">` or `keyed<collection<IHook>, "audit">`.  `D` is
+/// any other marker except `refreshable<T>`; injected as `D` would be.
+/// A keyed singleton with no registration of its own binds to the member
+/// of its singleton family for `Key`.
+template <typename D, fixed_string Key>
+struct keyed { using type = D; };
+
+/// `TImpl` can stand in for `I` in `exact<I, TImpl>` / `get_exact<I, TImpl>()`:
+/// a final class reached from `I` by a constant-offset downcast.
+template <typename TImpl, typename I>
+concept exact_impl_of = std::is_final_v<TImpl> && non_virtual_base_of<TImpl, I>;
+
 // ---------------------------------------------------------------
 // dep_traits — extract injection metadata from a dep declaration
 // ---------------------------------------------------------------
@@ -97,10 +156,63 @@ struct dep_traits<collection<transient<T>>> {
     static constexpr bool is_transient  = true;
 };
 
+/// `refreshable<T>` → inject as `refreshable_ref<T>`.
+template <typename T>
+struct dep_traits<refreshable<T>> {
+    using interface_type = T;
+    using inject_type    = refreshable_ref<T>;
+    static constexpr bool is_collection = false;
+    static constexpr bool is_transient  = false;
+};
+
+/// `exact<I, TImpl>` → singleton single, inject as `TImpl&`.
+template <typename I, typename TImpl>
+struct dep_traits<exact<I, TImpl>> {
+    static_assert(exact_impl_of<TImpl, I>,
+                  "exact<I, TImpl>: TImpl must be a final class with I as a non-virtual base");
+    using interface_type = I;
+    using inject_type    = TImpl&;
+    using exact_type     = TImpl;
+    static constexpr bool is_collection = false;
+    static constexpr bool is_transient  = false;
+};
+
 /// Helper alias.
 template <typename D>
 using inject_type_t = typename dep_traits<D>::inject_type;
 
+/// True for `refreshable<T>` dependencies.
+template <typename D>
+inline constexpr bool is_refreshable_dep_v = false;
+
+template <typename T>
+inline constexpr bool is_refreshable_dep_v<refreshable<T>> = true;
+
+/// True for `exact<I, TImpl>` dependencies.
+template <typename D>
+inline constexpr bool is_exact_dep_v = false;
+
+template <typename I, typename TImpl>
+inline constexpr bool is_exact_dep_v<exact<I, TImpl>> = true;
+
+template <typename D, fixed_string Key>
+inline constexpr bool is_exact_dep_v<keyed<D, Key>> = is_exact_dep_v<D>;
+
+/// Key of a `keyed<D, Key>` dependency; empty for every other marker.
+template <typename D>
+inline constexpr std::string_view dep_key_v{};
+
+template <typename D, fixed_string Key>
+inline constexpr std::string_view dep_key_v<keyed<D, Key>> = Key.view();
+
+/// `keyed<D, Key>` → as `D`, resolved under `Key`.
+template <typename D, fixed_string Key>
+struct dep_traits<keyed<D, Key>> : dep_traits<D> {
+    static_assert(!is_refreshable_dep_v<D>,
+                  "keyed<refreshable<T>, Key>: refreshable handles are not keyed");
+    static_assert(dep_key_v<D>.empty(), "keyed<D, Key>: D is already keyed");
+};
+
 // ---------------------------------------------------------------
 // Constructibility concept
 // ---------------------------------------------------------------
@@ -110,6 +222,11 @@ template <typename TImpl, typename... Deps>
 concept constructible_from_deps =
     std::is_constructible_v<TImpl, inject_type_t<Deps>...>;
 
+/// Singleton-family member: TImpl(std::string_view key, deps...).
+template <typename TImpl, typename... Deps>
+concept family_constructible_from_deps =
+    std::is_constructible_v<TImpl, std::string_view, inject_type_t<Deps>...>;
+
 // ---------------------------------------------------------------
 // Decorator concepts
 // ---------------------------------------------------------------
@@ -124,4 +241,27 @@ template <typename TDecorator, typename TInterface, typename... TExtra>
 concept decorator_constructible_with_deps =
     std::is_constructible_v<TDecorator, decorated_ptr<TInterface>, inject_type_t<TExtra>...>;
 
+// ---------------------------------------------------------------
+// Static decorator chains
+// ---------------------------------------------------------------
+
+namespace detail {
+
+template <typename T, template <typename> class... Layers>
+struct chain_of { using type = T; };
+
+template <typename T, template <typename> class Layer, template <typename> class... Rest>
+struct chain_of<T, Layer, Rest...> {
+    using type = typename chain_of<Layer<T>, Rest...>::type;
+};
+
+} // namespace detail
+
+/// Mixin layers composed over TImpl at compile time:
+/// `static_chain<T, A, B>` is `B<A<T>>`, so the first layer is innermost
+/// (like the first `decorate()` call).  Each layer derives from its
+/// template argument and calls `Base::method()` directly.
+template <typename TImpl, template <typename> class... Layers>
+using static_chain = typename detail::chain_of<TImpl, Layers...>::type;
+
 } // namespace librtdi
@@ -0,0 +1,36 @@
+#include "librtdi/compiled_graph.hpp"
+#include "librtdi/resolver.hpp"
+#include "resolver_graph.hpp"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace librtdi {
+
+compiled_graph::compiled_graph(std::shared_ptr<const internal::resolver_graph> graph)
+    : graph_(std::move(graph))
+{}
+
+compiled_graph::~compiled_graph() = default;
+
+const std::vector<descriptor>& compiled_graph::descriptors() const {
+    return graph_->descriptors;
+}
+
+const build_options& compiled_graph::options() const {
+    return graph_->options;
+}
+
+std::shared_ptr<resolver> compiled_graph::instantiate() const {
+    auto r = resolver::create(graph_);
+
+    // Eager singleton instantiation: resolve all singletons (phase by phase
+    // when startup phases are declared) so that factory errors surface at
+    // build time and first-request latency is eliminated.
+    r->start_up();
+
+    return r;
+}
+
+} // namespace librtdi
@@ -5,6 +5,8 @@
 #include <typeindex>
 #include <string>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #if defined(__GNUC__)
 #include <cxxabi.h>
@@ -180,4 +182,49 @@ resolution_error::resolution_error(std::type_index type,
 
 
 
+eager_construction_error::eager_construction_error(std::vector<failure> failures,
+                                                   std::vector<std::type_index> skipped,
+                                                   std::source_location loc)
+    : di_error(build_message(failures, skipped), loc)
+    , failures_(std::move(failures))
+    , skipped_(std::move(skipped))
+{
+    std::string detail;
+    for (const auto& f : failures_) {
+        if (f.diagnostic_detail.empty()) continue;
+        if (!detail.empty()) detail += "\n";
+        detail += internal::demangle(f.component_type) + ":\n" + f.diagnostic_detail;
+    }
+    set_diagnostic_detail(std::move(detail));
+}
+
+std::string eager_construction_error::build_message(
+        const std::vector<failure>& failures,
+        const std::vector<std::type_index>& skipped) {
+    std::string msg = "Eager construction failed for " + std::to_string(failures.size())
+                      + " singleton(s)";
+    if (!skipped.empty()) {
+        msg += ", " + std::to_string(skipped.size()) + " dependent(s) skipped";
+    }
+    for (const auto& f : failures) {
+        msg += "\n  - " + f.message;
+    }
+    if (!skipped.empty()) {
+        msg += "\n  skipped:";
+        for (std::size_t i = 0; i < skipped.size(); ++i) {
+            msg += (i == 0 ? " " : ", ") + internal::demangle(skipped[i]);
+        }
+    }
+    return msg;
+}
+
+construction_timeout::construction_timeout(std::type_index type,
+                                           std::chrono::milliseconds elapsed,
+                                           const std::string& message,
+                                           std::source_location loc)
+    : di_error(message, loc)
+    , component_type_(type)
+    , elapsed_(elapsed)
+{}
+
 } // namespace librtdi
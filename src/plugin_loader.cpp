@@ -0,0 +1,99 @@
+#include "plugin_loader.hpp"
+#include "librtdi/exceptions.hpp"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#if defined(_WIN32) || defined(__CYGWIN__)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+namespace librtdi::internal {
+
+namespace {
+
+#if defined(_WIN32) || defined(__CYGWIN__)
+
+using library_handle = HMODULE;
+
+library_handle open_library(const std::string& path, std::string& error) {
+    auto h = LoadLibraryA(path.c_str());
+    if (!h) error = "LoadLibrary failed with error " + std::to_string(GetLastError());
+    return h;
+}
+
+void* find_symbol(library_handle h, const std::string& symbol, std::string& error) {
+    auto p = GetProcAddress(h, symbol.c_str());
+    if (!p) error = "GetProcAddress failed with error " + std::to_string(GetLastError());
+    return reinterpret_cast<void*>(p);
+}
+
+#else
+
+using library_handle = void*;
+
+library_handle open_library(const std::string& path, std::string& error) {
+    auto* h = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!h) {
+        const char* msg = dlerror();
+        error = msg ? msg : "dlopen failed";
+    }
+    return h;
+}
+
+void* find_symbol(library_handle h, const std::string& symbol, std::string& error) {
+    dlerror();
+    void* p = dlsym(h, symbol.c_str());
+    if (!p) {
+        const char* msg = dlerror();
+        error = msg ? msg : "symbol is null";
+    }
+    return p;
+}
+
+#endif
+
+// Process-wide cache of loaded libraries, keyed by the path as registered.
+std::mutex& library_mutex() {
+    static std::mutex m;
+    return m;
+}
+
+std::unordered_map<std::string, library_handle>& library_cache() {
+    // Intentionally leaked: handles are never closed, and the map must stay
+    // valid for plugins resolved during static destruction.
+    static auto* cache = new std::unordered_map<std::string, library_handle>();
+    return *cache;
+}
+
+} // namespace
+
+plugin_entry_fn load_plugin_entry(const std::string& library,
+                                  const std::string& symbol) {
+    std::lock_guard lock(library_mutex());
+
+    auto& cache = library_cache();
+    auto it = cache.find(library);
+    if (it == cache.end()) {
+        std::string error;
+        auto h = open_library(library, error);
+        if (!h) {
+            throw di_error("Failed to load plugin library '" + library + "': " + error);
+        }
+        it = cache.emplace(library, h).first;
+    }
+
+    std::string error;
+    void* sym = find_symbol(it->second, symbol, error);
+    if (!sym) {
+        throw di_error("Plugin entry '" + symbol + "' not found in '" + library
+                       + "': " + error);
+    }
+    return reinterpret_cast<plugin_entry_fn>(sym);
+}
+
+} // namespace librtdi::internal
@@ -0,0 +1,18 @@
+#pragma once
+
+// Internal helper for loading plugin entry points from shared objects.
+// This header is NOT installed — it is only used by the library's .cpp files.
+
+#include "librtdi/descriptor.hpp"
+
+#include <string>
+
+namespace librtdi::internal {
+
+/// Load `library` (once per process) and look up `symbol` in it.
+/// Throws di_error if either step fails.  Libraries are never unloaded:
+/// instances and their deleters live in the plugin's code.
+plugin_entry_fn load_plugin_entry(const std::string& library,
+                                  const std::string& symbol);
+
+} // namespace librtdi::internal
@@ -1,21 +1,56 @@
 #include "librtdi/registry.hpp"
 #include "librtdi/resolver.hpp"
+#include "plugin_loader.hpp"
+#include "resolver_graph.hpp"
 #include "stacktrace_utils.hpp"
 
 #include <algorithm>
 #include <cassert>
+#include <functional>
+#include <iterator>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <source_location>
+#include <unordered_set>
 #include <vector>
 #include <typeindex>
 #include <stdexcept>
 
 namespace librtdi {
 
+namespace {
+
+// Single-instance slot identity: (type, key, lifetime)
+struct single_slot {
+    std::type_index type;
+    std::string key;
+    lifetime_kind lifetime;
+
+    bool operator==(const single_slot&) const = default;
+};
+
+struct single_slot_hash {
+    static void combine(std::size_t& h, std::size_t v) noexcept {
+        h ^= v + std::size_t{0x9e3779b9} + (h << 6) + (h >> 2);
+    }
+
+    std::size_t operator()(const single_slot& s) const noexcept {
+        auto h = s.type.hash_code();
+        combine(h, std::hash<std::string>{}(s.key));
+        combine(h, static_cast<std::size_t>(s.lifetime));
+        return h;
+    }
+};
+
+} // namespace
+
 void validate_descriptors(const std::vector<descriptor>& descriptors,
                           const build_options& options,
                           std::source_location loc);
+void check_startup_phases(const std::vector<descriptor>& descriptors,
+                          const build_options& options,
+                          std::source_location loc);
 
 // ---------------------------------------------------------------
 // Impl
@@ -37,6 +72,36 @@ struct registry::Impl {
     };
     std::vector<DecoratorEntry> decorators;
 
+    // Variant candidates stored until build() binds one per slot
+    struct VariantEntry {
+        descriptor desc;
+        variant_predicate when;
+    };
+    std::vector<VariantEntry> variants;
+
+    // Toggleable decorators stored until build() attaches them
+    struct ToggleEntry {
+        std::type_index interface_type;
+        toggle_layer layer;
+        std::vector<dependency_info> extra_deps;
+        std::source_location loc;
+        std::any stacktrace;
+        std::string api_name;
+    };
+    std::vector<ToggleEntry> toggles;
+
+    // Static decorator chains stored until build() applies them
+    struct StaticChainEntry {
+        std::type_index interface_type;
+        std::type_index impl_type;
+        factory_fn factory;
+        std::vector<dependency_info> deps;
+        std::source_location loc;
+        std::any stacktrace;
+        std::string api_name;
+    };
+    std::vector<StaticChainEntry> static_chains;
+
     // Forward entries stored until build() expands them
     struct ForwardEntry {
         std::type_index interface_type;
@@ -49,15 +114,32 @@ struct registry::Impl {
     };
     std::vector<ForwardEntry> forwards;
 
+    // Policy entries stored until build() applies them
+    struct PolicyEntry {
+        std::type_index interface_type;
+        std::optional<std::type_index> target_impl;
+        registry::policy_fn apply;
+        std::source_location loc;
+        std::string api_name;
+    };
+    std::vector<PolicyEntry> policies;
+
+    // Occupied single-instance slots (O(1) duplicate detection)
+    std::unordered_set<single_slot, single_slot_hash> single_slots;
+
+    // Single-instance slots claimed by add_variant() candidates
+    std::unordered_set<single_slot, single_slot_hash> variant_slots;
+
     // Check if a single-instance slot is already occupied
     bool has_single(std::type_index type, const std::string& key,
                     lifetime_kind lt) const {
-        return std::any_of(descriptors.begin(), descriptors.end(),
-            [&](const descriptor& d) {
-                return d.component_type == type && d.key == key
-                    && d.lifetime == lt && !d.is_collection;
-            });
+        return single_slots.contains(single_slot{type, key, lt});
     }
+
+    // ⓪–③ of compile(): bind variants, expand forwards, apply static
+    // chains, decorators and policies.
+    // `index_base` is where descriptors[0] lands in the final table.
+    void expand_deferred(std::size_t index_base = 0);
 };
 
 // ---------------------------------------------------------------
@@ -91,7 +173,8 @@ registry& registry::register_single(
     }
 
     // Check uniqueness for single-instance slots
-    if (impl_->has_single(type, key, lifetime)) {
+    if (impl_->has_single(type, key, lifetime) ||
+        impl_->variant_slots.contains(single_slot{type, key, lifetime})) {
         if (key.empty()) {
             throw duplicate_registration(type, loc);
         } else {
@@ -99,6 +182,7 @@ registry& registry::register_single(
         }
     }
 
+    impl_->single_slots.insert(single_slot{type, key, lifetime});
     impl_->descriptors.push_back(descriptor{
         type, lifetime, std::move(factory), std::move(deps),
         std::move(key), /*is_collection=*/false, std::move(impl_type),
@@ -108,6 +192,46 @@ registry& registry::register_single(
     return *this;
 }
 
+// ---------------------------------------------------------------
+// Variant registration (bound by build())
+// ---------------------------------------------------------------
+
+registry& registry::register_variant(
+        std::type_index type, lifetime_kind lifetime,
+        factory_fn factory, std::vector<dependency_info> deps,
+        std::string key, std::optional<std::type_index> impl_type,
+        variant_predicate when,
+        std::source_location loc, std::any stacktrace,
+        std::string api_name) {
+    if (impl_->built) {
+        throw di_error("Cannot register components after build() has been called", loc);
+    }
+    if (!factory) {
+        throw di_error("Component factory cannot be empty", loc);
+    }
+    if (!when) {
+        throw di_error("Variant predicate cannot be empty", loc);
+    }
+
+    // Candidates share their slot with each other, not with add_singleton etc.
+    if (impl_->has_single(type, key, lifetime)) {
+        if (key.empty()) {
+            throw duplicate_registration(type, loc);
+        } else {
+            throw duplicate_registration(type, key, loc);
+        }
+    }
+
+    impl_->variant_slots.insert(single_slot{type, key, lifetime});
+    impl_->variants.push_back({descriptor{
+        type, lifetime, std::move(factory), std::move(deps),
+        std::move(key), /*is_collection=*/false, std::move(impl_type),
+        std::nullopt, nullptr, loc, std::move(stacktrace),
+        std::move(api_name)
+    }, std::move(when)});
+    return *this;
+}
+
 // ---------------------------------------------------------------
 // Collection slot registration
 // ---------------------------------------------------------------
@@ -134,6 +258,116 @@ registry& registry::register_collection(
     return *this;
 }
 
+// ---------------------------------------------------------------
+// Stateless transients (built without a factory frame)
+// ---------------------------------------------------------------
+
+registry& registry::fold_stateless(stateless_fn make) noexcept {
+    auto& desc = impl_->descriptors.back();
+    if (desc.lifetime == lifetime_kind::transient) desc.stateless = make;
+    return *this;
+}
+
+// ---------------------------------------------------------------
+// Refreshable registration (singleton slot, swappable instance)
+// ---------------------------------------------------------------
+
+registry& registry::register_refreshable(
+        std::type_index type,
+        factory_fn factory, std::vector<dependency_info> deps,
+        std::string key, std::optional<std::type_index> impl_type,
+        std::source_location loc, std::any stacktrace,
+        std::string api_name) {
+    register_single(type, lifetime_kind::singleton, std::move(factory),
+                    std::move(deps), std::move(key), std::move(impl_type),
+                    loc, std::move(stacktrace), std::move(api_name));
+    impl_->descriptors.back().refreshable = true;
+    return *this;
+}
+
+// ---------------------------------------------------------------
+// Evictable registration (singleton slot, rebuildable instance)
+// ---------------------------------------------------------------
+
+registry& registry::register_evictable(
+        std::type_index type,
+        factory_fn factory, std::vector<dependency_info> deps,
+        std::string key, std::optional<std::type_index> impl_type,
+        std::size_t accounted_size,
+        std::source_location loc, std::any stacktrace,
+        std::string api_name) {
+    register_single(type, lifetime_kind::singleton, std::move(factory),
+                    std::move(deps), std::move(key), std::move(impl_type),
+                    loc, std::move(stacktrace), std::move(api_name));
+    auto& desc = impl_->descriptors.back();
+    desc.evictable = true;
+    desc.accounted_size = accounted_size;
+    return *this;
+}
+
+// ---------------------------------------------------------------
+// Family registration (singleton slot, one instance per runtime key)
+// ---------------------------------------------------------------
+
+registry& registry::register_family(
+        std::type_index type,
+        factory_fn factory, std::vector<dependency_info> deps,
+        std::optional<std::type_index> impl_type,
+        std::size_t max_instances,
+        std::source_location loc, std::any stacktrace,
+        std::string api_name) {
+    register_single(type, lifetime_kind::singleton, std::move(factory),
+                    std::move(deps), std::string{}, std::move(impl_type),
+                    loc, std::move(stacktrace), std::move(api_name));
+    auto& desc = impl_->descriptors.back();
+    desc.family = true;
+    desc.family_capacity = max_instances;
+    return *this;
+}
+
+// ---------------------------------------------------------------
+// Plugin registration (factory loaded on first resolution)
+// ---------------------------------------------------------------
+
+registry& registry::register_plugin(
+        std::type_index type, lifetime_kind lifetime,
+        std::string library, std::string symbol,
+        std::vector<dependency_info> deps,
+        std::source_location loc, std::any stacktrace,
+        std::string api_name) {
+    if (library.empty() || symbol.empty()) {
+        throw di_error("Plugin library path and entry symbol cannot be empty", loc);
+    }
+
+    struct plugin_state {
+        std::string library;
+        std::string symbol;
+        std::once_flag loaded;
+        plugin_entry_fn entry = nullptr;
+    };
+    auto state = std::make_shared<plugin_state>();
+    state->library = std::move(library);
+    state->symbol = std::move(symbol);
+
+    factory_fn factory = [state](resolver& r) -> erased_ptr {
+        // A failed load leaves the flag unset, so the next resolution retries.
+        std::call_once(state->loaded, [&] {
+            state->entry = internal::load_plugin_entry(state->library, state->symbol);
+        });
+        erased_ptr out;
+        state->entry(r, out);
+        if (!out) {
+            throw di_error("Plugin entry '" + state->symbol + "' in '" + state->library
+                           + "' returned an empty instance");
+        }
+        return out;
+    };
+
+    return register_single(type, lifetime, std::move(factory), std::move(deps),
+                           std::string{}, std::nullopt, loc,
+                           std::move(stacktrace), std::move(api_name));
+}
+
 // ---------------------------------------------------------------
 // Forward registration (deferred to build)
 // ---------------------------------------------------------------
@@ -177,32 +411,168 @@ registry& registry::register_decorator(
     return *this;
 }
 
+// ---------------------------------------------------------------
+// Toggleable decorator registration (deferred to build)
+// ---------------------------------------------------------------
+
+registry& registry::register_toggle(
+        std::type_index interface_type,
+        toggle_layer layer,
+        std::vector<dependency_info> extra_deps,
+        std::source_location loc,
+        std::any stacktrace,
+        std::string api_name) {
+    if (impl_->built) {
+        throw di_error("Cannot register decorators after build() has been called", loc);
+    }
+    impl_->toggles.push_back({interface_type, std::move(layer), std::move(extra_deps),
+                              loc, std::move(stacktrace), std::move(api_name)});
+    return *this;
+}
+
+// ---------------------------------------------------------------
+// Static decorator chain registration (deferred to build)
+// ---------------------------------------------------------------
+
+registry& registry::register_static_chain(
+        std::type_index interface_type,
+        std::type_index impl_type,
+        factory_fn factory,
+        std::vector<dependency_info> deps,
+        std::source_location loc,
+        std::any stacktrace,
+        std::string api_name) {
+    if (impl_->built) {
+        throw di_error("Cannot register decorators after build() has been called", loc);
+    }
+    impl_->static_chains.push_back({interface_type, impl_type, std::move(factory),
+                                     std::move(deps), loc, std::move(stacktrace),
+                                     std::move(api_name)});
+    return *this;
+}
+
+// ---------------------------------------------------------------
+// Policy registration (deferred to build)
+// ---------------------------------------------------------------
+
+registry& registry::register_policy(
+        std::type_index interface_type,
+        std::optional<std::type_index> target_impl,
+        policy_fn apply,
+        std::source_location loc,
+        std::string api_name) {
+    if (impl_->built) {
+        throw di_error("Cannot register policies after build() has been called", loc);
+    }
+    impl_->policies.push_back({interface_type, std::move(target_impl),
+                               std::move(apply), loc, std::move(api_name)});
+    return *this;
+}
+
+// ---------------------------------------------------------------
+// merge
+// ---------------------------------------------------------------
+
+registry& registry::merge(registry&& other, std::source_location loc) {
+    if (impl_->built || other.impl_->built) {
+        throw di_error("Cannot merge registries after build() has been called", loc);
+    }
+    if (&other == this) {
+        return *this;
+    }
+
+    // Check every incoming single slot before touching *this, so a
+    // duplicate leaves both registries unchanged.
+    auto reject = [](const descriptor& d) {
+        if (d.key.empty()) {
+            throw duplicate_registration(d.component_type, d.registration_location);
+        }
+        throw duplicate_registration(d.component_type, d.key, d.registration_location);
+    };
+    for (const auto& d : other.impl_->descriptors) {
+        if (d.is_collection) continue;
+        if (impl_->has_single(d.component_type, d.key, d.lifetime) ||
+            impl_->variant_slots.contains(single_slot{d.component_type, d.key, d.lifetime})) {
+            reject(d);
+        }
+    }
+    for (const auto& v : other.impl_->variants) {
+        if (impl_->has_single(v.desc.component_type, v.desc.key, v.desc.lifetime)) {
+            reject(v.desc);
+        }
+    }
+
+    auto append = [](auto& dst, auto& src) {
+        dst.insert(dst.end(),
+                   std::make_move_iterator(src.begin()),
+                   std::make_move_iterator(src.end()));
+        src.clear();
+    };
+
+    impl_->single_slots.merge(other.impl_->single_slots);
+    impl_->variant_slots.merge(other.impl_->variant_slots);
+    append(impl_->variants, other.impl_->variants);
+    append(impl_->descriptors, other.impl_->descriptors);
+    append(impl_->forwards, other.impl_->forwards);
+    append(impl_->static_chains, other.impl_->static_chains);
+    append(impl_->decorators, other.impl_->decorators);
+    append(impl_->toggles, other.impl_->toggles);
+    append(impl_->policies, other.impl_->policies);
+    return *this;
+}
+
 const std::vector<descriptor>& registry::descriptors() const {
     return impl_->descriptors;
 }
 
 // ---------------------------------------------------------------
-// build
+// Deferred entries: forwards, decorators, policies
 // ---------------------------------------------------------------
 
-std::shared_ptr<resolver> registry::build(build_options options, std::source_location loc) {
-    if (impl_->built) {
-        throw di_error("build() can only be called once", loc);
+void registry::Impl::expand_deferred(std::size_t index_base) {
+    // ⓪ Bind variants: the first candidate of each slot whose predicate
+    //    holds joins the descriptors; the rest are dropped unevaluated.
+    {
+        std::unordered_set<single_slot, single_slot_hash> bound;
+        for (auto& v : variants) {
+            single_slot slot{v.desc.component_type, v.desc.key, v.desc.lifetime};
+            if (bound.contains(slot)) continue;
+
+            bool chosen = false;
+            try {
+                chosen = v.when();
+            } catch (const std::exception& e) {
+                std::string what = "add_variant: predicate of " +
+                    internal::demangle(v.desc.component_type);
+                if (v.desc.impl_type) {
+                    what += " [impl: " + internal::demangle(*v.desc.impl_type) + "]";
+                }
+                auto ex = di_error(what + " threw: " + e.what(), v.desc.registration_location);
+                ex.set_diagnostic_detail(internal::format_registration_trace(v.desc));
+                throw ex;
+            }
+            if (chosen) {
+                bound.insert(slot);
+                descriptors.push_back(std::move(v.desc));
+            }
+        }
+        variants.clear();
+        variant_slots.clear();
     }
 
     // ① Forward expansion: for each forward entry, replicate all matching
     //    target descriptors (all 4 slots) under the interface type.
     {
         std::vector<descriptor> expanded;
-        for (auto& fwd : impl_->forwards) {
+        for (auto& fwd : forwards) {
             bool found_any = false;
-            for (std::size_t i = 0; i < impl_->descriptors.size(); ++i) {
-                auto& target = impl_->descriptors[i];
+            for (std::size_t i = 0; i < descriptors.size(); ++i) {
+                auto& target = descriptors[i];
                 if (target.component_type != fwd.target_type) continue;
                 if (!target.key.empty()) continue; // forward only expands non-keyed
 
                 found_any = true;
-                std::size_t target_idx = i;
+                std::size_t target_idx = index_base + i;
                 auto cast = fwd.cast;
 
                 if (target.lifetime == lifetime_kind::singleton) {
@@ -228,6 +598,7 @@ std::shared_ptr<resolver> registry::build(build_options options, std::source_loc
                         fwd.stacktrace,
                         fwd.api_name
                     };
+                    fwd_desc.alias_of = target_idx;
                     expanded.push_back(std::move(fwd_desc));
                 } else {
                     // Transient: create fresh via target, then cast.
@@ -274,15 +645,46 @@ std::shared_ptr<resolver> registry::build(build_options options, std::source_loc
         }
 
         for (auto& desc : expanded) {
-            impl_->descriptors.push_back(std::move(desc));
+            descriptors.push_back(std::move(desc));
         }
     }
 
-    // ② Apply decorators: wrap descriptor factories in registered order.
+    // ② Apply static chains first: a chain replaces the factory of the
+    //    registrations of (I, TImpl) it names.  Forward-expanded descriptors
+    //    are skipped; they resolve the replaced target and pick it up.
+    for (std::size_t c = 0; c < static_chains.size(); ++c) {
+        const auto& chain = static_chains[c];
+        for (std::size_t other = 0; other < c; ++other) {
+            if (static_chains[other].interface_type == chain.interface_type &&
+                static_chains[other].impl_type == chain.impl_type) {
+                throw di_error("decorate_static: " + internal::demangle(chain.interface_type) +
+                               " [impl: " + internal::demangle(chain.impl_type) +
+                               "] already has a static chain", chain.loc);
+            }
+        }
+
+        for (auto& desc : descriptors) {
+            if (desc.component_type != chain.interface_type) continue;
+            if (desc.impl_type != chain.impl_type || desc.forward_target) continue;
+
+            if (desc.dependencies != chain.deps) {
+                auto ex = di_error("decorate_static: deps<> of the chain for " +
+                                   internal::demangle(chain.interface_type) + " [impl: " +
+                                   internal::demangle(chain.impl_type) +
+                                   "] differ from the registration's", chain.loc);
+                ex.set_diagnostic_detail(internal::format_registration_trace(desc));
+                throw ex;
+            }
+            desc.factory = chain.factory;
+            desc.stateless = nullptr;
+        }
+    }
+
+    //    Then apply decorators: wrap descriptor factories in registered order.
     //    decorated_ptr<I> handles both owning (transient) and non-owning
     //    (forward-singleton) cases, so no descriptors need to be skipped.
-    for (auto& dec : impl_->decorators) {
-        for (auto& desc : impl_->descriptors) {
+    for (auto& dec : decorators) {
+        for (auto& desc : descriptors) {
             if (desc.component_type != dec.interface_type) continue;
 
             // Check if this decorator targets a specific impl
@@ -293,8 +695,12 @@ std::shared_ptr<resolver> registry::build(build_options options, std::source_loc
                 }
             }
 
-            // Wrap the factory
+            // Wrap the factory; a decorated forward owns its wrapper and
+            // can no longer share the target's cache entry
             desc.factory = dec.wrapper(std::move(desc.factory));
+            desc.alias_of.reset();
+            desc.decorated = true;
+            desc.stateless = nullptr;
 
             // Append extra dependencies
             for (auto& dep : dec.extra_deps) {
@@ -303,35 +709,90 @@ std::shared_ptr<resolver> registry::build(build_options options, std::source_loc
         }
     }
 
-    // ③ Validate before building
-    if (options.validate_on_build) {
-        validate_descriptors(impl_->descriptors, options, loc);
+    //    Toggleable decorators go outside every ordinary one.  A toggled
+    //    forward singleton gets its own cache entry, like a decorated one.
+    for (auto& tog : toggles) {
+        for (auto& desc : descriptors) {
+            if (desc.component_type != tog.interface_type) continue;
+            if (desc.toggles.size() == 64) {
+                throw di_error("decorate_toggleable: more than 64 toggleable decorators on " +
+                               internal::demangle(desc.component_type), tog.loc);
+            }
+            desc.toggles.push_back(tog.layer);
+            desc.alias_of.reset();
+            desc.decorated = true;
+            for (auto& dep : tog.extra_deps) {
+                desc.dependencies.push_back(dep);
+            }
+        }
     }
 
-    // ④ Collect singleton descriptor indices before descriptors are moved.
-    std::vector<std::size_t> singleton_indices;
-    if (options.eager_singletons) {
-        for (std::size_t i = 0; i < impl_->descriptors.size(); ++i) {
-            if (impl_->descriptors[i].lifetime == lifetime_kind::singleton) {
-                singleton_indices.push_back(i);
+    // ③ Apply policies: same matching rules as decorators, so forward-
+    //    expanded descriptors of I are covered as well.
+    for (auto& pol : policies) {
+        for (auto& desc : descriptors) {
+            if (desc.component_type != pol.interface_type) continue;
+            if (pol.target_impl.has_value()) {
+                if (!desc.impl_type.has_value() ||
+                    desc.impl_type.value() != pol.target_impl.value()) {
+                    continue;
+                }
             }
+            pol.apply(desc);
         }
     }
+}
+
+// ---------------------------------------------------------------
+// build
+// ---------------------------------------------------------------
+
+std::shared_ptr<resolver> registry::build(build_options options, std::source_location loc) {
+    return compile(options, loc)->instantiate();
+}
+
+// ---------------------------------------------------------------
+// compile
+// ---------------------------------------------------------------
+
+std::shared_ptr<const compiled_graph> registry::compile(build_options options,
+                                                        std::source_location loc) {
+    if (impl_->built) {
+        throw di_error("build() or compile() can only be called once", loc);
+    }
+
+    impl_->expand_deferred();
+    check_startup_phases(impl_->descriptors, options, loc);
+
+    // ④ Validate before building
+    if (options.validate_on_build) {
+        validate_descriptors(impl_->descriptors, options, loc);
+    }
 
     impl_->built = true;
 
-    auto r = resolver::create(std::move(impl_->descriptors));
+    // ⑤ Freeze the descriptor tables.  Eager singleton creation happens per
+    //    resolver in compiled_graph::instantiate().
+    auto graph = std::make_shared<const internal::resolver_graph>(
+        std::move(impl_->descriptors), options);
+    return std::shared_ptr<const compiled_graph>(new compiled_graph(std::move(graph)));
+}
 
-    // ⑤ Eager singleton instantiation: resolve all singletons now so that
-    //    factory errors surface at build time and first-request latency is
-    //    eliminated.
-    if (options.eager_singletons) {
-        for (auto idx : singleton_indices) {
-            r->resolve_singleton_by_index(idx);
-        }
+// ---------------------------------------------------------------
+// compile_overlay (resolver::create_child)
+// ---------------------------------------------------------------
+
+std::vector<descriptor> registry::compile_overlay(std::size_t index_base,
+                                                  std::source_location loc) {
+    if (impl_->built) {
+        throw di_error("Override registry has already been built", loc);
     }
 
-    return r;
+    // Forwards and decorators see only the overriding registrations; the
+    // parent's descriptors were already expanded when it was compiled.
+    impl_->expand_deferred(index_base);
+    impl_->built = true;
+    return std::move(impl_->descriptors);
 }
 
 } // namespace librtdi
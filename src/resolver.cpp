@@ -1,12 +1,27 @@
 #include "librtdi/resolver.hpp"
 #include "librtdi/exceptions.hpp"
+#include "librtdi/registry.hpp"
+#include "resolver_graph.hpp"
 #include "stacktrace_utils.hpp"
+#include "watchdog.hpp"
 
 #include <algorithm>
-#include <map>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <latch>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <shared_mutex>
+#include <stop_token>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <typeindex>
 #include <string>
@@ -14,40 +29,938 @@
 #include <utility>
 #include <tuple>
 
+#if defined(__SANITIZE_ADDRESS__)
+#define LIBRTDI_HAS_LSAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(leak_sanitizer)
+#define LIBRTDI_HAS_LSAN 1
+#endif
+#endif
+
+#ifdef LIBRTDI_HAS_LSAN
+#include <sanitizer/lsan_interface.h>
+#endif
+
 namespace librtdi {
 
-// ---------------------------------------------------------------
-// Slot key: (type, key, lifetime, is_collection) → identifies a slot
-// ---------------------------------------------------------------
+void validate_overlay(const internal::resolver_graph& graph,
+                      std::source_location loc);
+void check_startup_phases(const std::vector<descriptor>& descriptors,
+                          const build_options& options,
+                          std::source_location loc);
+
+namespace {
+
+// Tell LeakSanitizer that a leaked singleton is intentional so that it (and
+// everything reachable from it) is not reported at process exit.
+void mark_intentional_leak([[maybe_unused]] const void* p) noexcept {
+#ifdef LIBRTDI_HAS_LSAN
+    if (p) __lsan_ignore_object(p);
+#endif
+}
+
+// Published instance of one refreshable or evictable descriptor.  Readers
+// only load `current`; writers (creation, refresh) serialize on `writer`.
+// Eviction swaps `current` to null without taking `writer`.
+struct refresh_cell {
+    std::atomic<std::shared_ptr<void>> current;
+    std::mutex writer;
+    std::vector<std::pair<std::size_t, std::function<void(void*)>>> subscribers;
+    std::size_t next_subscriber = 0;
+
+    // Evictable cells only
+    bool evictable = false;
+    std::size_t accounted_size = 0;
+    std::atomic<std::uint64_t> last_use{0};
+};
+
+// Members of one singleton family, spread over shards so that a lookup
+// only takes its shard's lock (shared) and an insert changes one map entry.
+// Creation and eviction are serialized on the resolver's singleton_mutex;
+// factories run outside it, claimed per key (see resolver::impl).
+//
+// Members are also threaded on two intrusive lists guarded by list_mutex:
+// creation order (teardown, newest first) and, in capped families, use
+// order (eviction, least recent first).  Both unlink in O(1).
+struct family_member {
+    erased_ptr instance;
+    std::string key;
+
+    bool linked = false;                  // still on the lists (not evicted)
+    family_member* created_prev = nullptr;
+    family_member* created_next = nullptr;
+    family_member* used_prev = nullptr;   // capped families only
+    family_member* used_next = nullptr;
+};
+
+struct family_cache {
+    static constexpr std::size_t shard_count = 16;
+
+    struct shard {
+        std::shared_mutex mutex;
+        std::unordered_map<std::string, std::shared_ptr<family_member>> members;
+    };
+
+    explicit family_cache(std::size_t cap) : capacity(cap) {}
+
+    const std::size_t capacity;   // 0 = unlimited
+    std::array<shard, shard_count> shards;
+
+    std::mutex list_mutex;
+    family_member* oldest_created = nullptr;
+    family_member* newest_created = nullptr;
+    family_member* least_used = nullptr;
+    family_member* most_used = nullptr;
+    std::size_t linked = 0;
+
+    // Guarded by singleton_mutex: keys whose factory is running, with the
+    // thread that claimed them, and whether the family is in creation_order
+    std::unordered_map<std::string, std::thread::id> building;
+    bool listed = false;
+
+    shard& shard_for(const std::string& key) {
+        return shards[std::hash<std::string>{}(key) % shard_count];
+    }
+
+    std::shared_ptr<family_member> find(const std::string& key) {
+        auto& s = shard_for(key);
+        std::shared_lock lock(s.mutex);
+        auto it = s.members.find(key);
+        return it == s.members.end() ? nullptr : it->second;
+    }
+
+    // Mark `m` most recently used (capped families)
+    void touch(family_member& m) {
+        if (capacity == 0) return;
+        std::lock_guard lock(list_mutex);
+        if (!m.linked || most_used == &m) return;
+        unlink_used(m);
+        link_used(m);
+    }
+
+    // Caller holds singleton_mutex.  Publishes `m` (its key is not cached)
+    // and returns the member it evicts, if any; the caller drops that one
+    // after releasing its locks.
+    std::shared_ptr<family_member> insert(std::shared_ptr<family_member> m) {
+        family_member* victim = nullptr;
+        {
+            std::lock_guard lock(list_mutex);
+            m->linked = true;
+            m->created_prev = newest_created;
+            (newest_created ? newest_created->created_next : oldest_created) = m.get();
+            newest_created = m.get();
+            ++linked;
+            if (capacity != 0) {
+                link_used(*m);
+                if (linked > capacity) {
+                    // Nothing but guards refers to a member (enforced by
+                    // validation), so the least recently used one can go
+                    victim = least_used;
+                    unlink_used(*victim);
+                    unlink_created(*victim);
+                    victim->linked = false;
+                    --linked;
+                }
+            }
+        }
+        {
+            auto& s = shard_for(m->key);
+            std::unique_lock lock(s.mutex);
+            s.members.emplace(m->key, m);
+        }
+        if (!victim) return nullptr;
+        auto& s = shard_for(victim->key);
+        std::unique_lock lock(s.mutex);
+        auto node = s.members.extract(victim->key);
+        return std::move(node.mapped());
+    }
+
+    // Caller holds singleton_mutex.  Removes every member, newest first,
+    // handing each to `drop` outside the cache's locks.
+    template <typename Drop>
+    void clear(Drop drop) noexcept {
+        family_member* m = nullptr;
+        {
+            std::lock_guard lock(list_mutex);
+            m = newest_created;
+            for (auto* it = m; it; it = it->created_prev) it->linked = false;
+            oldest_created = newest_created = least_used = most_used = nullptr;
+            linked = 0;
+        }
+        while (m) {
+            auto* older = m->created_prev;
+            std::shared_ptr<family_member> member;
+            {
+                auto& s = shard_for(m->key);
+                std::unique_lock lock(s.mutex);
+                member = std::move(s.members.extract(m->key).mapped());
+            }
+            drop(std::move(member));
+            m = older;
+        }
+    }
+
+private:
+    void link_used(family_member& m) {
+        m.used_next = nullptr;
+        m.used_prev = most_used;
+        (most_used ? most_used->used_next : least_used) = &m;
+        most_used = &m;
+    }
+
+    void unlink_used(family_member& m) {
+        (m.used_prev ? m.used_prev->used_next : least_used) = m.used_next;
+        (m.used_next ? m.used_next->used_prev : most_used) = m.used_prev;
+        m.used_prev = m.used_next = nullptr;
+    }
+
+    void unlink_created(family_member& m) {
+        (m.created_prev ? m.created_prev->created_next : oldest_created) = m.created_next;
+        (m.created_next ? m.created_next->created_prev : newest_created) = m.created_prev;
+        m.created_prev = m.created_next = nullptr;
+    }
+};
+
+// A get_many<Ds...>() plan: the slot of each dependency (null for handles
+// and unregistered slots).
+struct batch_plan {
+    std::vector<const std::vector<std::size_t>*> slots;
+    std::size_t missing = 0;   // first unregistered single-instance slot, or slots.size()
+    bool locked = false;       // has singleton slots, resolved under the lock
+};
+
+// Plans by resolver::next_batch_plan_id().  Chunk k holds 64 << k atomic
+// pointers and is allocated on first use, so a cached plan is found with
+// neither a lock nor a hash lookup.  Chunks and plans are published by
+// compare-and-swap: a thread that loses a race discards its own copy.
+class batch_plan_table {
+public:
+    batch_plan_table() = default;
+    batch_plan_table(const batch_plan_table&) = delete;
+    batch_plan_table& operator=(const batch_plan_table&) = delete;
+
+    ~batch_plan_table() {
+        for (std::size_t k = 0; k < chunk_count; ++k) {
+            auto* chunk = chunks_[k].load(std::memory_order_relaxed);
+            if (!chunk) continue;
+            for (std::size_t i = 0; i < (first_chunk << k); ++i) {
+                delete chunk[i].load(std::memory_order_relaxed);
+            }
+            delete[] chunk;
+        }
+    }
+
+    const batch_plan* find(std::size_t id) const noexcept {
+        auto [k, offset] = locate(id);
+        auto* chunk = chunks_[k].load(std::memory_order_acquire);
+        return chunk ? chunk[offset].load(std::memory_order_acquire) : nullptr;
+    }
+
+    // The plan now cached for `id`: `plan`, or the one another thread
+    // published first.
+    const batch_plan* publish(std::size_t id, std::unique_ptr<const batch_plan> plan) {
+        auto [k, offset] = locate(id);
+        auto* chunk = chunks_[k].load(std::memory_order_acquire);
+        if (!chunk) {
+            auto fresh = std::make_unique<std::atomic<const batch_plan*>[]>(first_chunk << k);
+            if (chunks_[k].compare_exchange_strong(chunk, fresh.get(),
+                                                   std::memory_order_acq_rel)) {
+                chunk = fresh.release();
+            }
+        }
+        const batch_plan* expected = nullptr;
+        if (chunk[offset].compare_exchange_strong(expected, plan.get(),
+                                                  std::memory_order_acq_rel)) {
+            return plan.release();
+        }
+        return expected;
+    }
+
+private:
+    static constexpr std::size_t first_chunk = 64;
+    // Covers 64 * (2^32 - 1) ids, more than there can be instantiations
+    static constexpr std::size_t chunk_count = 32;
+
+    static std::pair<std::size_t, std::size_t> locate(std::size_t id) noexcept {
+        const std::size_t k = static_cast<std::size_t>(std::bit_width(id / first_chunk + 1)) - 1;
+        return {k, id - first_chunk * ((std::size_t{1} << k) - 1)};
+    }
+
+    std::array<std::atomic<std::atomic<const batch_plan*>*>, chunk_count> chunks_{};
+};
+
+// Cache entry of a singleton with toggleable decorators: the undecorated
+// instance plus one non-owning layer chain per combination of enabled
+// layers built so far.  `current` is what get<T>() hands out.
+struct toggle_holder {
+    erased_ptr base;
+    std::vector<std::pair<std::uint64_t, std::vector<erased_ptr>>> chains;
+    std::atomic<void*> current{nullptr};
+
+    ~toggle_holder() {
+        // Outer layers first, the wrapped instance last
+        for (auto chain = chains.rbegin(); chain != chains.rend(); ++chain) {
+            auto& layers = chain->second;
+            while (!layers.empty()) layers.pop_back();
+        }
+    }
+
+    // Point `current` at the chain for `mask`, building it on first use
+    void select(const descriptor& desc, std::uint64_t mask, resolver& r) {
+        void* top = base.get();
+        if (mask != 0) {
+            auto it = std::find_if(chains.begin(), chains.end(),
+                                   [mask](const auto& c) { return c.first == mask; });
+            if (it == chains.end()) {
+                std::vector<erased_ptr> layers;
+                for (std::size_t i = 0; i < desc.toggles.size(); ++i) {
+                    if ((mask >> i & 1U) == 0) continue;
+                    layers.push_back(desc.toggles[i].wrap(r, erased_ptr(top, nullptr)));
+                    top = layers.back().get();
+                }
+                chains.emplace_back(mask, std::move(layers));
+            } else {
+                top = it->second.back().get();
+            }
+        }
+        current.store(top, std::memory_order_release);
+    }
+};
+
+// Recursive mutex of the singleton cache.  Unlike std::recursive_mutex its
+// owner can release it completely while waiting for a singleton that another
+// thread is building (that thread may need the lock to finish), and take it
+// back at the same depth afterwards.
+class cache_mutex {
+public:
+    void lock() {
+        const auto self = std::this_thread::get_id();
+        if (owner_.load(std::memory_order_relaxed) == self) {
+            ++depth_;
+            return;
+        }
+        mutex_.lock();
+        owner_.store(self, std::memory_order_relaxed);
+        depth_ = 1;
+    }
+
+    void unlock() {
+        if (--depth_ == 0) {
+            owner_.store(std::thread::id{}, std::memory_order_relaxed);
+            mutex_.unlock();
+        }
+    }
+
+    // Caller owns the lock, at any depth.  Releases it until `ready` holds,
+    // as signalled through `cv`.
+    template <typename Pred>
+    void wait(std::condition_variable& cv, Pred ready) {
+        const auto depth = std::exchange(depth_, 0);
+        owner_.store(std::thread::id{}, std::memory_order_relaxed);
+        std::unique_lock lock(mutex_, std::adopt_lock);
+        cv.wait(lock, ready);
+        lock.release();
+        owner_.store(std::this_thread::get_id(), std::memory_order_relaxed);
+        depth_ = depth;
+    }
+
+private:
+    std::mutex mutex_;
+    std::atomic<std::thread::id> owner_{};
+    std::size_t depth_ = 0;
+};
+
+std::shared_ptr<void> to_shared(erased_ptr ep) {
+    auto deleter = ep.deleter;
+    void* raw = ep.release();
+    if (!deleter) {
+        return std::shared_ptr<void>(raw, [](void*) {});
+    }
+    return std::shared_ptr<void>(raw, deleter);
+}
+
+// Nesting depth of factory calls on this thread.  Non-zero means this
+// thread may hold a resolver lock, so work must not be handed to other
+// threads that could need it.
+thread_local int t_factory_depth = 0;
+
+// Cancellation of the outermost watched factory call on this thread; its
+// nested calls share it.  See resolver::construction_stop_token().
+thread_local std::stop_source t_construction_stop{std::nostopstate};
+
+// Key of the family member whose factory is running on this thread
+// (internal::current_family_key()).
+thread_local std::string_view t_family_key;
+
+// This thread is running the resolver's startup (eager singletons or
+// startup phases): a hard timeout here fails build().
+thread_local bool t_in_startup = false;
+
+// Descriptors whose factories are running on this thread, outermost first.
+// A factory that fails leaves its entry behind, so once the exception
+// reaches the outermost frame the chain still lists every level it left.
+thread_local std::vector<const descriptor*> t_resolution_chain;
+
+// The exception the chain currently describes.  A factory may swallow a
+// nested failure and then throw its own; the frame that first sees the new
+// exception trims the entries the swallowed one left behind.
+thread_local std::exception_ptr t_failure;
+
+// A descriptor whose factory is already running on this thread is being
+// re-entered: the dependency graph has a cycle that build-time validation
+// did not (or was not asked to) catch.  Report it instead of recursing
+// until the stack overflows.
+[[noreturn]] void throw_runtime_cycle(
+        std::vector<const descriptor*>::const_iterator first,
+        const descriptor& desc) {
+    std::vector<std::type_index> cycle;
+    std::string detail;
+    for (auto it = first; it != t_resolution_chain.cend(); ++it) {
+        cycle.push_back((*it)->component_type);
+        auto trace = internal::format_registration_trace(**it);
+        if (!trace.empty()) {
+            if (!detail.empty()) detail += "\n";
+            detail += trace;
+        }
+    }
+    cycle.push_back(desc.component_type);
+    auto ex = cyclic_dependency(cycle);
+    if (!detail.empty()) ex.set_diagnostic_detail(detail);
+    throw ex;
+}
+
+class resolution_frame {
+public:
+    explicit resolution_frame(const descriptor& desc)
+        : depth_(static_cast<std::size_t>(t_factory_depth)) {
+        // Entries past our depth belong to a failure some factory swallowed
+        t_resolution_chain.resize(depth_);
+        auto it = std::find(t_resolution_chain.cbegin(), t_resolution_chain.cend(), &desc);
+        if (it != t_resolution_chain.cend()) throw_runtime_cycle(it, desc);
+        t_resolution_chain.push_back(&desc);
+        ++t_factory_depth;
+    }
+
+    ~resolution_frame() {
+        --t_factory_depth;
+        if (depth_ == 0 || std::uncaught_exceptions() <= uncaught_) {
+            t_resolution_chain.resize(depth_);
+        }
+        if (depth_ == 0) t_failure = nullptr;
+    }
+
+    resolution_frame(const resolution_frame&) = delete;
+    resolution_frame& operator=(const resolution_frame&) = delete;
+
+    bool outermost() const noexcept { return depth_ == 0; }
+
+    // Called while the exception leaving this frame is being handled: if
+    // it is not the one the chain already describes, it was thrown by this
+    // factory, and anything recorded past this frame is stale.
+    void note_failure() {
+        auto current = std::current_exception();
+        if (current == t_failure) return;
+        t_failure = std::move(current);
+        t_resolution_chain.resize(depth_ + 1);
+    }
+
+private:
+    std::size_t depth_;
+    int uncaught_ = std::uncaught_exceptions();
+};
+
+// Registers one factory call with the resolver's watchdog (if any) for the
+// duration of the call.  Constructed after the resolution_frame, so the
+// chain already ends with the descriptor being built.
+class construction_watch {
+public:
+    explicit construction_watch(internal::watchdog* dog) : dog_(dog) {
+        if (!dog_) return;
+        if (!t_construction_stop.stop_possible()) {
+            t_construction_stop = std::stop_source{};
+            owns_stop_ = true;
+        }
+        id_ = dog_->begin(t_resolution_chain, t_construction_stop, t_in_startup);
+    }
+
+    ~construction_watch() {
+        if (!dog_) return;
+        dog_->end(id_);
+        if (owns_stop_) t_construction_stop = std::stop_source{std::nostopstate};
+    }
+
+    construction_watch(const construction_watch&) = delete;
+    construction_watch& operator=(const construction_watch&) = delete;
+
+private:
+    internal::watchdog* dog_;
+    std::uint64_t id_ = 0;
+    bool owns_stop_ = false;
+};
+
+// Attach the recorded chain to `e`, innermost first, skipping the `skip`
+// innermost entries: "... (while resolving C -> B -> A)".  The diagnostic
+// detail falls back to the innermost registration that has a trace.
+void annotate_with_chain(di_error& e, std::size_t skip) {
+    std::string ctx;
+    for (auto i = t_resolution_chain.size(); i-- > 0;) {
+        const auto& d = *t_resolution_chain[i];
+        if (e.diagnostic_detail().empty()) {
+            auto trace = internal::format_registration_trace(d);
+            if (!trace.empty()) e.set_diagnostic_detail(trace);
+        }
+        if (skip > 0) {
+            --skip;
+            continue;
+        }
+        if (!ctx.empty()) ctx += " -> ";
+        ctx += internal::demangle(d.component_type);
+        if (d.impl_type.has_value()) {
+            ctx += " [impl: " + internal::demangle(d.impl_type.value()) + "]";
+        }
+    }
+    if (!ctx.empty()) e.append_resolution_context(ctx);
+}
+
+// Run `build` in a resolution frame for `desc`, annotating failures with
+// resolution context.  Nested frames only note the failure and rethrow; the
+// outermost frame on this thread attaches the whole chain, once.
+template <typename Fn>
+auto in_resolution_frame(const descriptor& desc, internal::watchdog* dog, Fn&& build) {
+    resolution_frame frame(desc);
+    construction_watch watch(dog);
+    if (!frame.outermost()) {
+        try {
+            return build();
+        } catch (...) {
+            frame.note_failure();
+            throw;
+        }
+    }
+
+    try {
+        return build();
+    } catch (di_error& e) {
+        // Caught by non-const reference so the exception can be enriched
+        // before rethrowing it with its original type.
+        frame.note_failure();
+        annotate_with_chain(e, 0);
+        throw;
+    } catch (const std::exception& e) {
+        frame.note_failure();
+        // Foreign exceptions are wrapped on behalf of the factory that threw
+        const auto& failing = *t_resolution_chain.back();
+        auto ex = resolution_error(failing.component_type, e,
+                               failing.registration_location,
+                               std::source_location::current());
+        ex.set_diagnostic_detail(
+            internal::format_registration_trace(failing));
+        annotate_with_chain(ex, 1);
+        throw ex;
+    }
+}
+
+// Run a descriptor's factory in its resolution frame.
+erased_ptr invoke_factory(const descriptor& desc, resolver& r, internal::watchdog* dog) {
+    return in_resolution_frame(desc, dog, [&] { return desc.factory(r); });
+}
+
+// Progress of the resolver's startup, shared with the task running it and
+// with the watchdog, whichever settles it first.
+struct startup_state {
+    std::mutex mutex;
+    std::condition_variable finished_cv;
+    bool finished = false;
+    std::exception_ptr error;
+    std::vector<std::promise<void>> phases;
+    std::size_t settled = 0;              // phases fulfilled so far
+    std::atomic<bool> abandoned{false};   // failed by a hard timeout
+
+    void phase_done(std::size_t k) {
+        std::lock_guard lock(mutex);
+        if (finished || settled != k) return;
+        phases[k].set_value();
+        ++settled;
+    }
+
+    // Record the outcome, fail the phases not fulfilled yet and wake build()
+    void finish(std::exception_ptr e) {
+        {
+            std::lock_guard lock(mutex);
+            if (finished) return;
+            finished = true;
+            error = e;
+            for (; settled < phases.size(); ++settled) phases[settled].set_exception(e);
+        }
+        finished_cv.notify_all();
+    }
+};
+
+// Run task(0..n-1) on `executor` and wait for all of them.  Returns the
+// exception of the lowest failing index, if any.
+std::exception_ptr run_on_executor(const task_executor& executor, std::size_t n,
+                                   const std::function<void(std::size_t)>& task) {
+    std::vector<std::exception_ptr> errors(n);
+    std::latch done(static_cast<std::ptrdiff_t>(n));
+    std::exception_ptr submit_error;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        try {
+            executor([&, i] {
+                try {
+                    task(i);
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+                done.count_down();
+            });
+        } catch (...) {
+            // Tasks that were never submitted will not count down.
+            submit_error = std::current_exception();
+            done.count_down(static_cast<std::ptrdiff_t>(n - i));
+            break;
+        }
+    }
+    done.wait();
+
+    if (submit_error) return submit_error;
+    for (auto& e : errors) {
+        if (e) return e;
+    }
+    return nullptr;
+}
+
+// Group the members of one collection slot into waves: a member waits for
+// every other member it (transitively) depends on.  Members within a wave
+// are independent of each other.
+std::vector<std::vector<std::size_t>> member_waves(const internal::resolver_graph& graph,
+                                                   const std::vector<std::size_t>& members) {
+    const std::size_t n = members.size();
+    std::unordered_map<std::size_t, std::size_t> position;
+    for (std::size_t p = 0; p < n; ++p) {
+        position.emplace(graph.canonical_index(members[p]), p);
+    }
+
+    std::vector<std::vector<std::size_t>> needs(n);
+    for (std::size_t p = 0; p < n; ++p) {
+        std::size_t start = graph.canonical_index(members[p]);
+        std::unordered_set<std::size_t> visited{start};
+        std::vector<std::size_t> stack{start};
+        while (!stack.empty()) {
+            auto idx = stack.back();
+            stack.pop_back();
+            const auto& deps = graph.at(idx).dependencies;
+            for (std::size_t d = 0; d < deps.size(); ++d) {
+                const auto* slot = graph.bound_dependencies(idx)[d];
+                if (deps[d].is_refreshable || !slot) continue;
+                for (auto raw : *slot) {
+                    auto next = graph.canonical_index(raw);
+                    if (!visited.insert(next).second) continue;
+                    if (auto it = position.find(next); it != position.end()) {
+                        needs[p].push_back(it->second);
+                    } else {
+                        stack.push_back(next);
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<std::vector<std::size_t>> waves;
+    std::vector<unsigned char> placed(n, 0);
+    std::size_t remaining = n;
+    while (remaining > 0) {
+        std::vector<std::size_t> wave;
+        for (std::size_t p = 0; p < n; ++p) {
+            if (placed[p]) continue;
+            bool ready = std::all_of(needs[p].begin(), needs[p].end(),
+                                     [&](std::size_t q) { return placed[q] != 0; });
+            if (ready) wave.push_back(p);
+        }
+        if (wave.empty()) {
+            // Members depend on each other in a cycle (validation is off):
+            // leave them to sequential resolution.
+            for (std::size_t p = 0; p < n; ++p) {
+                if (!placed[p]) waves.push_back({p});
+            }
+            break;
+        }
+        for (auto p : wave) placed[p] = 1;
+        remaining -= wave.size();
+        waves.push_back(std::move(wave));
+    }
+    return waves;
+}
 
-using slot_key = std::tuple<std::type_index, std::string, lifetime_kind, bool>;
+} // namespace
 
 // ---------------------------------------------------------------
-// Impl — shared resolver state
+// Impl — per-resolver state over shared, immutable descriptor tables
 // ---------------------------------------------------------------
 
 struct resolver::impl {
-    std::vector<descriptor> descriptors;
+    std::shared_ptr<const internal::resolver_graph> graph;
+
+    // Child resolvers only: instances of inherited singletons live here
+    std::shared_ptr<resolver> parent;
 
-    // Index: slot_key → list of descriptor indices in that slot
-    std::map<slot_key, std::vector<std::size_t>> slot_to_indices;
+    // Refreshable descriptor index → cell.  Filled at construction and
+    // never modified afterwards, so lookups need no lock.
+    std::unordered_map<std::size_t, std::shared_ptr<refresh_cell>> refresh_cells;
+
+    // refresh_cells in a fixed order: the order prepare_fork() locks them.
+    std::vector<refresh_cell*> ordered_cells;
+
+    // Evictable subset of refresh_cells, plus LRU clock and accounting.
+    // trim_mutex serializes eviction passes.
+    std::vector<refresh_cell*> evictable_cells;
+    std::atomic<std::uint64_t> use_clock{0};
+    std::atomic<std::size_t> resident_bytes{0};
+    std::mutex trim_mutex;
+
+    // Singleton families owned here: descriptor index → members.  Filled at
+    // construction; members are added and evicted under singleton_mutex.
+    // ordered_families: the same caches in the order prepare_fork() locks them.
+    std::unordered_map<std::size_t, std::unique_ptr<family_cache>> families;
+    std::vector<family_cache*> ordered_families;
 
     // Singleton cache: descriptor index → erased_ptr
-    std::recursive_mutex singleton_mutex;
+    cache_mutex singleton_mutex;
+
+    // Singletons (and families) whose factory is running, with the thread
+    // that claimed them.  Guarded by singleton_mutex; built_cv is notified
+    // whenever a claim ends.
+    std::unordered_map<std::size_t, std::thread::id> building;
+    std::condition_variable built_cv;
+
+    // One readiness future per build_options::startup_phases entry,
+    // set up by start_up() before the resolver is handed out.
+    std::vector<std::shared_future<void>> phase_ready;
+    std::shared_ptr<startup_state> startup;
+
+    // Runs startup when some factory has a hard deadline, so that build()
+    // can give up on a factory that does not return.  Joined at teardown,
+    // unless the teardown runs on it (the task held the last reference).
+    std::jthread startup_thread;
+    bool hard_deadlines = false;
     std::unordered_map<std::size_t, erased_ptr> singletons;
     std::vector<std::size_t> creation_order;
 
-    explicit impl(std::vector<descriptor> descs)
-        : descriptors(std::move(descs))
+    // get_many<Ds...>() plans; read and published without a lock
+    batch_plan_table batch_plans;
+
+    // Parallel collection construction: slot → waves of member positions.
+    // Guarded by singleton_mutex.
+    std::unordered_map<const std::vector<std::size_t>*,
+                       std::vector<std::vector<std::size_t>>> collection_waves;
+
+    // Toggleable-decorator state: descriptor index → one flag per layer.
+    // Filled at construction and never reshaped, so reads need no lock.
+    // toggled lists the indices, parent levels first.
+    std::unordered_map<std::size_t, std::unique_ptr<std::atomic<bool>[]>> toggle_flags;
+    std::vector<std::size_t> toggled;
+
+    // Construction watchdog; null unless some factory has a deadline.
+    // Declared last: its thread may still be reporting on the members above.
+    std::unique_ptr<internal::watchdog> watchdog;
+
+    impl(std::shared_ptr<const internal::resolver_graph> g,
+         std::shared_ptr<resolver> parent_resolver)
+        : graph(std::move(g))
+        , parent(std::move(parent_resolver))
     {
-        for (std::size_t i = 0; i < descriptors.size(); ++i) {
-            auto& d = descriptors[i];
-            auto sk = slot_key(d.component_type, d.key, d.lifetime, d.is_collection);
-            slot_to_indices[sk].push_back(i);
+        graph->for_each_toggled([&](std::size_t idx) {
+            const auto& layers = graph->at(idx).toggles;
+            auto flags = std::make_unique<std::atomic<bool>[]>(layers.size());
+            for (std::size_t i = 0; i < layers.size(); ++i) {
+                flags[i].store(layers[i].enabled, std::memory_order_relaxed);
+            }
+            toggle_flags.emplace(idx, std::move(flags));
+            toggled.push_back(idx);
+        });
+        for (auto idx : graph->refreshable_indices) {
+            if (!graph->is_inherited(idx)) {
+                auto cell = std::make_shared<refresh_cell>();
+                ordered_cells.push_back(cell.get());
+                refresh_cells.emplace(idx, std::move(cell));
+            }
+        }
+        for (auto idx : graph->family_indices) {
+            if (!graph->is_inherited(idx)) {
+                auto cache = std::make_unique<family_cache>(graph->at(idx).family_capacity);
+                ordered_families.push_back(cache.get());
+                families.emplace(idx, std::move(cache));
+            }
+        }
+        for (auto idx : graph->evictable_indices) {
+            if (!graph->is_inherited(idx)) {
+                auto cell = std::make_shared<refresh_cell>();
+                cell->evictable = true;
+                cell->accounted_size = graph->at(idx).accounted_size;
+                evictable_cells.push_back(cell.get());
+                ordered_cells.push_back(cell.get());
+                refresh_cells.emplace(idx, std::move(cell));
+            }
+        }
+
+        const auto& options = graph->options;
+        bool watched = options.factory_deadline != construction_deadline{}
+            || graph->any_deadline;
+        hard_deadlines = options.factory_deadline.hard.count() != 0
+            || graph->any_hard_deadline;
+        if (watched) {
+            watchdog = std::make_unique<internal::watchdog>(
+                options.factory_deadline, options.on_slow_factory,
+                [this](const slow_factory_report& report, bool in_startup) {
+                    if (in_startup) fail_startup(report);
+                });
+        }
+    }
+
+    // Hard timeout during startup: fail it and the pending phases now, and
+    // wake build().  The startup task stops once the factory, which was
+    // asked to stop, returns.
+    void fail_startup(const slow_factory_report& report) {
+        // Set by start_up() before any factory of the startup is watched
+        auto state = startup;
+        if (!state) return;
+        state->abandoned.store(true, std::memory_order_relaxed);
+        state->finish(std::make_exception_ptr(construction_timeout(
+            report.component_type, report.elapsed, report.message,
+            report.registration_location)));
+    }
+
+    std::uint64_t toggle_mask(std::size_t idx) const {
+        auto it = toggle_flags.find(idx);
+        if (it == toggle_flags.end()) return 0;
+        std::uint64_t mask = 0;
+        for (std::size_t i = 0; i < graph->at(idx).toggles.size(); ++i) {
+            if (it->second[i].load(std::memory_order_acquire)) mask |= std::uint64_t{1} << i;
+        }
+        return mask;
+    }
+
+    // Transient (and refreshable) instances: wrap in the enabled layers,
+    // each owning the one inside it.
+    erased_ptr wrap_toggled(std::size_t idx, erased_ptr ep, resolver& r) const {
+        const auto& layers = graph->at(idx).toggles;
+        if (layers.empty() || !ep) return ep;
+        auto mask = toggle_mask(idx);
+        for (std::size_t i = 0; i < layers.size(); ++i) {
+            if ((mask >> i & 1U) != 0) ep = layers[i].wrap(r, std::move(ep));
+        }
+        return ep;
+    }
+
+    // Singletons: the cache entry for `idx`, holding `instance` behind a
+    // toggle_holder when the descriptor has toggleable layers.
+    erased_ptr cache_entry(std::size_t idx, erased_ptr instance, resolver& r) const {
+        const auto& desc = graph->at(idx);
+        if (desc.toggles.empty()) return instance;
+        auto holder = std::make_unique<toggle_holder>();
+        holder->base = std::move(instance);
+        holder->select(desc, toggle_mask(idx), r);
+        return erased_ptr(holder.release(),
+                          [](void* p) { delete static_cast<toggle_holder*>(p); });
+    }
+
+    void* cached_instance(std::size_t idx, const erased_ptr& entry) const {
+        if (graph->at(idx).toggles.empty()) return entry.get();
+        return static_cast<toggle_holder*>(entry.get())->current.load(std::memory_order_acquire);
+    }
+
+    enum class claim { cached, owned, reentered };
+
+    // Caller holds singleton_mutex.  Claims the right to build `idx`, waiting
+    // (with the lock released) while another thread builds it, so a singleton
+    // factory runs once even when it runs outside the lock.  `reentered`:
+    // this thread already holds the claim further up its stack.
+    claim claim_build(std::size_t idx) {
+        const auto self = std::this_thread::get_id();
+        for (;;) {
+            if (singletons.count(idx) != 0) return claim::cached;
+            auto [it, inserted] = building.try_emplace(idx, self);
+            if (inserted) return claim::owned;
+            if (it->second == self) return claim::reentered;
+            singleton_mutex.wait(built_cv, [&] { return building.count(idx) == 0; });
+        }
+    }
+
+    // Ends an owned claim_build() claim, built or not, and wakes its waiters.
+    void end_build(std::size_t idx) noexcept {
+        {
+            std::lock_guard lock(singleton_mutex);
+            building.erase(idx);
+        }
+        built_cv.notify_all();
+    }
+
+    // claim_build() for the member of `cache` under `key`: members under
+    // other keys are built concurrently.
+    claim claim_member(family_cache& cache, const std::string& key) {
+        const auto self = std::this_thread::get_id();
+        for (;;) {
+            if (cache.find(key)) return claim::cached;
+            auto [it, inserted] = cache.building.try_emplace(key, self);
+            if (inserted) return claim::owned;
+            if (it->second == self) return claim::reentered;
+            singleton_mutex.wait(built_cv, [&] { return cache.building.count(key) == 0; });
         }
     }
 
+    void end_member(family_cache& cache, const std::string& key) noexcept {
+        {
+            std::lock_guard lock(singleton_mutex);
+            cache.building.erase(key);
+        }
+        built_cv.notify_all();
+    }
+
+    class member_claim {
+    public:
+        member_claim(impl& owner, family_cache& cache, const std::string& key,
+                     claim state) noexcept
+            : owner_(state == claim::owned ? &owner : nullptr), cache_(cache), key_(key) {}
+        ~member_claim() { if (owner_) owner_->end_member(cache_, key_); }
+
+        member_claim(const member_claim&) = delete;
+        member_claim& operator=(const member_claim&) = delete;
+
+    private:
+        impl* owner_;
+        family_cache& cache_;
+        const std::string& key_;
+    };
+
+    class build_claim {
+    public:
+        build_claim(impl& owner, std::size_t idx, claim state) noexcept
+            : owner_(state == claim::owned ? &owner : nullptr), idx_(idx) {}
+        ~build_claim() { if (owner_) owner_->end_build(idx_); }
+
+        build_claim(const build_claim&) = delete;
+        build_claim& operator=(const build_claim&) = delete;
+
+    private:
+        impl* owner_;
+        std::size_t idx_;
+    };
+
+    void touch(refresh_cell& cell) noexcept {
+        cell.last_use.store(use_clock.fetch_add(1, std::memory_order_relaxed) + 1,
+                            std::memory_order_relaxed);
+    }
+
     ~impl() noexcept {
+        if (startup_thread.joinable()
+            && startup_thread.get_id() == std::this_thread::get_id()) {
+            // The startup task is releasing the last reference on its way out
+            startup_thread.detach();
+        }
+        if (startup_thread.joinable()) startup_thread.join();
+        watchdog.reset();
+        // Refreshable instances may reference singletons: release them first.
+        refresh_cells.clear();
         teardown_singletons();
     }
 
@@ -55,28 +968,46 @@ struct resolver::impl {
                                               const std::string& key,
                                               lifetime_kind lt,
                                               bool is_coll) const {
-        auto it = slot_to_indices.find(slot_key(type, key, lt, is_coll));
-        if (it == slot_to_indices.end() || it->second.empty()) return nullptr;
-        return &it->second;
+        return graph->find_slot(type, key, lt, is_coll);
+    }
+
+    // Throws unless single slot `idx` of `type` holds an undecorated
+    // `impl_type` (get_exact / exact<I, TImpl>).
+    void check_exact(std::size_t idx, std::type_index type,
+                     std::type_index impl_type) const {
+        auto reason = internal::exact_binding_error(*graph, idx, impl_type);
+        if (!reason.empty()) {
+            throw di_error("exact<" + internal::demangle(type) + ", " +
+                           internal::demangle(impl_type) + ">: " + reason);
+        }
+    }
+
+    // Index whose cache entry holds the instance of `idx` (forward
+    // singletons alias their target's entry).
+    std::size_t cache_owner(std::size_t idx) const {
+        idx = graph->canonical_index(idx);
+        while (const auto& target = graph->at(idx).alias_of) {
+            idx = graph->canonical_index(*target);
+        }
+        return idx;
     }
 
     std::vector<std::size_t> singleton_dependencies_for(std::size_t idx,
                                                          bool& inconsistent) const {
         std::vector<std::size_t> deps;
-        if (idx >= descriptors.size()) {
+        if (idx >= graph->size()) {
             inconsistent = true;
             return deps;
         }
 
-        const auto& desc = descriptors[idx];
-        for (const auto& dep : desc.dependencies) {
+        const auto& desc = graph->at(idx);
+        for (std::size_t d = 0; d < desc.dependencies.size(); ++d) {
+            const auto& dep = desc.dependencies[d];
             if (dep.is_transient) {
                 continue;
             }
 
-            const auto* dep_indices = find_slot(dep.type, std::string{},
-                                                lifetime_kind::singleton,
-                                                dep.is_collection);
+            const auto* dep_indices = graph->bound_dependencies(idx)[d];
             if (!dep_indices) {
                 continue;
             }
@@ -85,14 +1016,14 @@ struct resolver::impl {
                 inconsistent = true;
             }
 
-            for (auto dep_idx : *dep_indices) {
-                if (dep_idx == idx) {
+            for (auto raw_idx : *dep_indices) {
+                if (raw_idx == idx) {
                     inconsistent = true;
                     continue;
                 }
 
-                auto it = singletons.find(dep_idx);
-                if (it == singletons.end()) {
+                auto dep_idx = cache_owner(raw_idx);
+                if (!created(dep_idx)) {
                     continue;
                 }
 
@@ -117,16 +1048,16 @@ struct resolver::impl {
             return {};
         }
 
-        std::vector<unsigned char> visit_state(descriptors.size(), 0);
+        std::unordered_map<std::size_t, unsigned char> visit_state;
         std::vector<std::size_t> order;
         order.reserve(creation_order.size());
 
         std::function<bool(std::size_t)> visit = [&](std::size_t idx) {
-            if (idx >= visit_state.size()) {
+            if (idx >= graph->size()) {
                 return false;
             }
 
-            if (singletons.find(idx) == singletons.end()) {
+            if (!created(idx)) {
                 return true;
             }
 
@@ -171,37 +1102,117 @@ struct resolver::impl {
         return order;
     }
 
+    bool leaks_on_exit(std::size_t idx) const noexcept {
+        if (idx >= graph->size()) {
+            return false;
+        }
+        switch (graph->at(idx).on_exit) {
+            case exit_policy::destroy: return false;
+            case exit_policy::leak:    return true;
+            case exit_policy::inherit: break;
+        }
+        return graph->options.fast_exit;
+    }
+
+    // `idx` has a cache entry here: a created singleton, or a family with
+    // at least one member.  Caller holds singleton_mutex.
+    bool created(std::size_t idx) const {
+        if (singletons.find(idx) != singletons.end()) return true;
+        auto it = families.find(idx);
+        return it != families.end() && it->second->listed;
+    }
+
+    // Drop every member of family `idx`, newest first.  Members still
+    // pinned by a read_guard are destroyed with their last guard; with
+    // `destroy` unset the instances are leaked instead.
+    void clear_family(std::size_t idx, bool destroy) noexcept {
+        auto it = families.find(idx);
+        if (it == families.end()) return;
+        auto& cache = *it->second;
+        cache.clear([destroy](std::shared_ptr<family_member> member) {
+            if (!destroy && member->instance.deleter) {
+                mark_intentional_leak(member->instance.release());
+            }
+        });
+        cache.listed = false;
+    }
+
     void reset_singleton_entry(std::size_t idx) noexcept {
+        if (idx < graph->size() && graph->at(idx).family) {
+            clear_family(idx, !leaks_on_exit(idx));
+            return;
+        }
         auto it = singletons.find(idx);
         if (it == singletons.end()) {
             return;
         }
 
+        if (it->second.deleter && leaks_on_exit(idx)) {
+            // Skip the destructor and the free: drop ownership only.
+            mark_intentional_leak(it->second.release());
+            return;
+        }
         it->second.reset();
     }
 
+    // Created singletons that must not survive into a forked child: those
+    // with fork_policy::reinitialize and every singleton that depends on
+    // one, directly or through transients.  Returned in creation order.
+    std::vector<std::size_t> stale_after_fork() const {
+        std::vector<unsigned char> stale(graph->size(), 0);
+        std::vector<unsigned char> visiting(graph->size(), 0);
+
+        std::function<bool(std::size_t)> reaches_stale = [&](std::size_t idx) {
+            const auto& deps = graph->at(idx).dependencies;
+            for (std::size_t d = 0; d < deps.size(); ++d) {
+                const auto* dep_indices = graph->bound_dependencies(idx)[d];
+                if (!dep_indices) continue;
+                for (auto dep_idx : *dep_indices) {
+                    dep_idx = graph->canonical_index(dep_idx);
+                    if (!deps[d].is_transient) {
+                        if (stale[dep_idx] != 0) return true;
+                    } else if (visiting[dep_idx] == 0) {
+                        // Transients hold whatever they were built from
+                        visiting[dep_idx] = 1;
+                        bool hit = reaches_stale(dep_idx);
+                        visiting[dep_idx] = 0;
+                        if (hit) return true;
+                    }
+                }
+            }
+            return false;
+        };
+
+        std::vector<std::size_t> result;
+        for (auto idx : creation_order) {
+            if (graph->at(idx).on_fork == fork_policy::reinitialize || reaches_stale(idx)) {
+                stale[idx] = 1;
+                result.push_back(idx);
+            }
+        }
+        return result;
+    }
+
     void teardown_singletons() noexcept {
         std::lock_guard lock(singleton_mutex);
-        if (singletons.empty()) {
-            creation_order.clear();
+        if (creation_order.empty()) {
+            singletons.clear();
             return;
         }
 
-        std::vector<unsigned char> reset_in_dependency_pass(descriptors.size(), 0);
+        std::unordered_set<std::size_t> reset_in_dependency_pass;
 
         try {
             for (auto idx : dependency_aware_teardown_order()) {
                 reset_singleton_entry(idx);
-                if (idx < reset_in_dependency_pass.size()) {
-                    reset_in_dependency_pass[idx] = 1;
-                }
+                reset_in_dependency_pass.insert(idx);
             }
         } catch (...) {
             // Fall back to reverse creation order if graph analysis fails.
         }
 
         for (auto it = creation_order.rbegin(); it != creation_order.rend(); ++it) {
-            if (*it < reset_in_dependency_pass.size() && reset_in_dependency_pass[*it] != 0) {
+            if (reset_in_dependency_pass.contains(*it)) {
                 continue;
             }
 
@@ -223,90 +1234,837 @@ resolver::resolver(std::unique_ptr<impl> p_impl)
 
 resolver::~resolver() = default;
 
-std::shared_ptr<resolver> resolver::create(std::vector<descriptor> descriptors) {
-    auto uni = std::make_unique<impl>(std::move(descriptors));
+std::shared_ptr<resolver> resolver::create(std::shared_ptr<const internal::resolver_graph> graph,
+                                           std::shared_ptr<resolver> parent) {
+    auto uni = std::make_unique<impl>(std::move(graph), std::move(parent));
     return std::shared_ptr<resolver>(new resolver(std::move(uni)));
 }
 
 // ---------------------------------------------------------------
-// Internal: resolve a singleton descriptor by index
+// Child resolvers
 // ---------------------------------------------------------------
 
-void* resolver::resolve_singleton_by_index(std::size_t idx) {
-    if (idx >= impl_->descriptors.size()) {
-        throw di_error("descriptor index out of range");
-    }
-    const auto& desc = impl_->descriptors[idx];
+std::shared_ptr<resolver> resolver::create_child(registry overrides,
+                                                 build_options options,
+                                                 std::source_location loc) {
+    auto own = overrides.compile_overlay(impl_->graph->size(), loc);
+    check_startup_phases(own, options, loc);
+    auto graph = std::make_shared<const internal::resolver_graph>(
+        impl_->graph, std::move(own), options);
 
-    std::lock_guard lock(impl_->singleton_mutex);
-    auto it = impl_->singletons.find(idx);
-    if (it != impl_->singletons.end()) {
-        return it->second.get();
+    if (options.validate_on_build) {
+        validate_overlay(*graph, loc);
     }
 
-    erased_ptr instance;
-    try {
-        instance = desc.factory(*this);
-    } catch (di_error& e) {
-        // Annotate with resolution context so nested failures show the
-        // full chain: "... (while resolving B -> A)". We intentionally catch
-        // di_error by non-const reference so we can enrich the exception
-        // (e.g., append_resolution_context / set_diagnostic_detail) before
-        // rethrowing it.
-        std::string ctx = internal::demangle(desc.component_type);
-        if (desc.impl_type.has_value()) {
-            ctx += " [impl: " + internal::demangle(desc.impl_type.value()) + "]";
-        }
-        e.append_resolution_context(ctx);
-        if (e.diagnostic_detail().empty()) {
-            auto trace = internal::format_registration_trace(desc);
-            if (!trace.empty()) e.set_diagnostic_detail(trace);
+    auto child = create(std::move(graph), shared_from_this());
+    child->start_up();
+    return child;
+}
+
+// ---------------------------------------------------------------
+// fork() support
+// ---------------------------------------------------------------
+
+void resolver::prepare_fork() {
+    // Threads do not survive fork(): stop the watchdog's before locking, as
+    // its reporter may be resolving.  Then take every lock another thread
+    // could hold mid-update, always in this order: cell writers (a refresh
+    // resolves its dependencies under its writer), trim, singletons,
+    // family shards and lists, startup, watchdog.
+    auto& im = *impl_;
+    if (im.watchdog) im.watchdog->pause();
+    for (auto* cell : im.ordered_cells) cell->writer.lock();
+    im.trim_mutex.lock();
+    im.singleton_mutex.lock();
+    for (auto* cache : im.ordered_families) {
+        for (auto& shard : cache->shards) shard.mutex.lock();
+        cache->list_mutex.lock();
+    }
+    if (im.startup) im.startup->mutex.lock();
+    if (im.watchdog) im.watchdog->lock_for_fork();
+}
+
+void resolver::after_fork_parent() {
+    auto& im = *impl_;
+    if (im.startup) im.startup->mutex.unlock();
+    for (auto it = im.ordered_families.rbegin(); it != im.ordered_families.rend(); ++it) {
+        (*it)->list_mutex.unlock();
+        for (auto& shard : (*it)->shards) shard.mutex.unlock();
+    }
+    im.singleton_mutex.unlock();
+    im.trim_mutex.unlock();
+    for (auto it = im.ordered_cells.rbegin(); it != im.ordered_cells.rend(); ++it) {
+        (*it)->writer.unlock();
+    }
+    if (im.watchdog) im.watchdog->resume(false);
+}
+
+void resolver::after_fork_child() {
+    auto& im = *impl_;
+
+    // Only the forking thread exists in the child; whoever waited on a lock
+    // at fork() time is gone.  Start over with fresh locks (the old ones are
+    // abandoned, not destroyed).
+    for (auto* cell : im.ordered_cells) std::construct_at(&cell->writer);
+    std::construct_at(&im.trim_mutex);
+    std::construct_at(&im.singleton_mutex);
+    std::construct_at(&im.built_cv);
+    im.building.clear();
+    for (auto* cache : im.ordered_families) {
+        for (auto& shard : cache->shards) std::construct_at(&shard.mutex);
+        std::construct_at(&cache->list_mutex);
+        cache->building.clear();
+    }
+    if (im.startup) {
+        std::construct_at(&im.startup->mutex);
+        std::construct_at(&im.startup->finished_cv);
+    }
+    // Nor does the startup thread: drop its handle without joining
+    std::construct_at(&im.startup_thread);
+    if (im.watchdog) im.watchdog->resume(true);
+
+    {
+        std::lock_guard lock(im.singleton_mutex);
+        auto stale = im.stale_after_fork();
+        const bool destroy = im.graph->options.destroy_stale_on_fork;
+        for (auto it = stale.rbegin(); it != stale.rend(); ++it) {
+            if (im.graph->at(*it).family) {
+                im.clear_family(*it, destroy);
+                continue;
+            }
+            auto entry = im.singletons.find(*it);
+            if (entry == im.singletons.end()) continue;
+            if (destroy) {
+                entry->second.reset();
+            } else if (entry->second.deleter) {
+                // Leave the parent's copy-on-write pages untouched.
+                mark_intentional_leak(entry->second.release());
+            }
+            im.singletons.erase(entry);
         }
-        throw;
-    } catch (const std::exception& e) {
-        auto ex = resolution_error(desc.component_type, e,
-                               desc.registration_location,
-                               std::source_location::current());
-        ex.set_diagnostic_detail(
-            internal::format_registration_trace(desc));
-        throw ex;
+
+        std::erase_if(im.creation_order, [&](std::size_t idx) { return !im.created(idx); });
+    }
+
+    // Rebuild what startup would have built, as build() does: eagerly or
+    // phase by phase, with fresh phase_ready() futures
+    start_up();
+}
+
+// ---------------------------------------------------------------
+// Internal: resolve a singleton descriptor by index
+// ---------------------------------------------------------------
+
+void* resolver::resolve_singleton_by_index(std::size_t idx) {
+    std::lock_guard lock(impl_->singleton_mutex);
+    return resolve_singleton_locked(idx);
+}
+
+// Caller holds singleton_mutex.
+void* resolver::resolve_singleton_locked(std::size_t idx) {
+    const auto& graph = *impl_->graph;
+    if (idx >= graph.size()) {
+        throw di_error("descriptor index out of range");
     }
+    idx = graph.canonical_index(idx);
+    if (graph.is_inherited(idx)) {
+        return impl_->parent->resolve_singleton_by_index(idx);
+    }
+    const auto& desc = graph.at(idx);
+    if (desc.refreshable || desc.evictable) {
+        throw di_error(internal::demangle(desc.component_type)
+                       + (desc.refreshable ? " is registered as refreshable"
+                                           : " is registered as evictable")
+                       + "; use acquire<T>()");
+    }
+    if (desc.family) {
+        throw di_error(internal::demangle(desc.component_type)
+                       + " is registered as a singleton family; use get<T>(key)");
+    }
+    if (desc.alias_of) {
+        // Forwarded singleton: no cache entry of its own.  Building the
+        // target runs in a frame of the forward's, so a failure still names
+        // the interface that was asked for ("while resolving IBase").
+        void* target = nullptr;
+        auto hit = impl_->singletons.find(graph.canonical_index(*desc.alias_of));
+        if (hit != impl_->singletons.end()) {
+            target = impl_->cached_instance(hit->first, hit->second);
+        } else {
+            target = in_resolution_frame(desc, nullptr, [&] {
+                return resolve_singleton_locked(*desc.alias_of);
+            });
+        }
+        return desc.forward_cast ? desc.forward_cast(target) : target;
+    }
+
+    auto it = impl_->singletons.find(idx);
+    if (it != impl_->singletons.end()) {
+        return impl_->cached_instance(idx, it->second);
+    }
+    auto state = impl_->claim_build(idx);
+    if (state == impl::claim::cached) {
+        return impl_->cached_instance(idx, impl_->singletons.at(idx));
+    }
+    impl::build_claim claim(*impl_, idx, state);
+
+    erased_ptr instance = impl_->cache_entry(
+        idx, invoke_factory(desc, *this, impl_->watchdog.get()), *this);
 
     auto [created_it, inserted] = impl_->singletons.emplace(idx, std::move(instance));
     if (inserted) {
         impl_->creation_order.push_back(idx);
     }
-    return created_it->second.get();
+    return impl_->cached_instance(idx, created_it->second);
 }
 
 erased_ptr resolver::resolve_transient_by_index(std::size_t idx) {
-    if (idx >= impl_->descriptors.size()) {
+    const auto& graph = *impl_->graph;
+    if (idx >= graph.size()) {
         throw di_error("descriptor index out of range");
     }
-    const auto& desc = impl_->descriptors[idx];
+    idx = graph.canonical_index(idx);
+    const auto& desc = graph.at(idx);
+
+    // Stateless transients have nothing to resolve and a nothrow
+    // constructor: skip the factory frame unless a watchdog times it.
+    // Only allocation can fail, and std::bad_alloc propagates as is.
+    auto built = desc.stateless && !impl_->watchdog
+        ? desc.stateless()
+        : invoke_factory(desc, *this, impl_->watchdog.get());
+    return impl_->wrap_toggled(idx, std::move(built), *this);
+}
+
+// ---------------------------------------------------------------
+// Eager creation
+// ---------------------------------------------------------------
+
+void resolver::create_eager_singletons() {
+    if (impl_->graph->options.collect_eager_errors) {
+        create_eager_singletons_collecting();
+        return;
+    }
+    for (auto idx : impl_->graph->singleton_indices) {
+        if (startup_abandoned()) return;
+        resolve_singleton_by_index(idx);
+    }
+    for (auto idx : impl_->graph->refreshable_indices) {
+        static_cast<void>(acquire_refreshable_by_index(idx));
+    }
+}
 
-    try {
-        return desc.factory(*this);
-    } catch (di_error& e) {
-        // Annotate with resolution context so nested failures show the
-        // full chain: "... (while resolving B -> A)"
-        std::string ctx = internal::demangle(desc.component_type);
-        if (desc.impl_type.has_value()) {
-            ctx += " [impl: " + internal::demangle(desc.impl_type.value()) + "]";
+void resolver::create_eager_singletons_collecting() {
+    const auto& graph = *impl_->graph;
+
+    std::unordered_map<std::size_t, unsigned char> eager;
+    for (auto idx : graph.singleton_indices) eager[graph.canonical_index(idx)] = 1;
+    for (auto idx : graph.refreshable_indices) eager[graph.canonical_index(idx)] = 2;
+
+    std::vector<eager_construction_error::failure> failures;
+    std::vector<std::type_index> skipped;
+
+    // Dependencies first, so a failure is reported once, by the factory
+    // that threw, and its dependents are skipped rather than re-running it.
+    std::unordered_map<std::size_t, unsigned char> state; // 0 new, 1 visiting, 2 ok, 3 failed
+    std::function<bool(std::size_t)> visit = [&](std::size_t idx) -> bool {
+        idx = graph.canonical_index(idx);
+        if (state[idx] == 1 || state[idx] == 2) return true; // cycles fail when built
+        if (state[idx] == 3) return false;
+        state[idx] = 1;
+
+        const auto& desc = graph.at(idx);
+        bool intact = !desc.alias_of || visit(*desc.alias_of);
+        for (const auto* dep_indices : graph.bound_dependencies(idx)) {
+            if (!dep_indices) continue;
+            for (auto j : *dep_indices) {
+                if (!visit(j)) intact = false;
+            }
         }
-        e.append_resolution_context(ctx);
-        if (e.diagnostic_detail().empty()) {
-            auto trace = internal::format_registration_trace(desc);
-            if (!trace.empty()) e.set_diagnostic_detail(trace);
+
+        auto kind = eager.find(idx);
+        if (!intact) {
+            state[idx] = 3;
+            if (kind != eager.end()) skipped.push_back(desc.component_type);
+            return false;
+        }
+        if (kind != eager.end()) {
+            auto record = [&](std::string message, std::string detail) {
+                failures.push_back({desc.component_type, desc.impl_type, std::move(message),
+                                    std::move(detail), std::current_exception()});
+                state[idx] = 3;
+            };
+            try {
+                if (kind->second == 1) {
+                    resolve_singleton_by_index(idx);
+                } else {
+                    static_cast<void>(acquire_refreshable_by_index(idx));
+                }
+            } catch (const di_error& e) {
+                record(e.what(), e.diagnostic_detail());
+                return false;
+            } catch (const std::exception& e) {
+                record(e.what(), internal::format_registration_trace(desc));
+                return false;
+            } catch (...) {
+                record("non-standard exception while resolving "
+                           + internal::demangle(desc.component_type),
+                       internal::format_registration_trace(desc));
+                return false;
+            }
+        }
+        state[idx] = 2;
+        return true;
+    };
+
+    for (auto idx : graph.singleton_indices) visit(idx);
+    for (auto idx : graph.refreshable_indices) visit(idx);
+
+    if (!failures.empty()) {
+        throw eager_construction_error(std::move(failures), std::move(skipped));
+    }
+}
+
+// ---------------------------------------------------------------
+// Startup phases
+// ---------------------------------------------------------------
+
+void resolver::start_up() {
+    const auto& options = impl_->graph->options;
+    const bool phased = !options.startup_phases.empty();
+    if (!phased && !options.eager_singletons) return;
+
+    auto state = std::make_shared<startup_state>();
+    state->phases.resize(options.startup_phases.size());
+    impl_->phase_ready.clear();
+    for (auto& p : state->phases) impl_->phase_ready.push_back(p.get_future().share());
+    impl_->startup = state;
+
+    // The task keeps this resolver alive while it runs; failures reach
+    // phase_ready() and build().  It lets go before settling the state, so
+    // a resolver dropped after build() is torn down by the caller.
+    auto task = [self = shared_from_this(), state, phased]() mutable {
+        t_in_startup = true;
+        std::exception_ptr error;
+        try {
+            if (phased) {
+                self->run_startup_phases();
+            } else {
+                self->create_eager_singletons();
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+        t_in_startup = false;
+        self.reset();
+        state->finish(error);
+    };
+
+    if (phased && options.phase_executor) {
+        options.phase_executor(std::move(task));
+        return;
+    }
+    if (impl_->hard_deadlines) {
+        // A hard timeout must fail build() even if the factory never
+        // returns: run startup on the resolver's own thread and wait for it
+        // to finish or for the watchdog to fail it.  A timed-out task keeps
+        // the resolver alive until the stuck factory returns.
+        impl_->startup_thread = std::jthread(std::move(task));
+    } else {
+        task();
+    }
+
+    std::unique_lock lock(state->mutex);
+    state->finished_cv.wait(lock, [&] { return state->finished; });
+    if (state->error) std::rethrow_exception(state->error);
+}
+
+bool resolver::startup_abandoned() const noexcept {
+    const auto& state = impl_->startup;
+    return state && state->abandoned.load(std::memory_order_relaxed);
+}
+
+void resolver::run_startup_phases() {
+    const auto& graph = *impl_->graph;
+    const auto& phases = graph.options.startup_phases;
+    const std::size_t last = phases.size() - 1;
+
+    // Phase of each startup singleton; unphased ones (and phases a parent
+    // declared but this resolver does not) go with the last phase when eager
+    auto phase_of = [&](const descriptor& d) -> std::optional<std::size_t> {
+        auto it = std::find(phases.begin(), phases.end(), d.startup_phase);
+        if (it != phases.end()) return static_cast<std::size_t>(it - phases.begin());
+        if (graph.options.eager_singletons) return last;
+        return std::nullopt;
+    };
+
+    // Dependency closure in construction order, skipping what earlier
+    // phases already pulled in
+    std::unordered_set<std::size_t> visited;
+    std::vector<std::size_t> order;
+    std::function<void(std::size_t)> collect = [&](std::size_t idx) {
+        idx = graph.canonical_index(idx);
+        if (!visited.insert(idx).second) return;
+        const auto& desc = graph.at(idx);
+        if (desc.alias_of) collect(*desc.alias_of);
+        for (const auto* dep_indices : graph.bound_dependencies(idx)) {
+            if (!dep_indices) continue;
+            for (auto j : *dep_indices) collect(j);
+        }
+        if (desc.lifetime == lifetime_kind::singleton && !desc.evictable && !desc.family) {
+            order.push_back(idx);
+        }
+    };
+
+    for (std::size_t k = 0; k < phases.size(); ++k) {
+        order.clear();
+        for (const auto* list : {&graph.singleton_indices, &graph.refreshable_indices}) {
+            for (auto idx : *list) {
+                if (phase_of(graph.at(graph.canonical_index(idx))) == k) collect(idx);
+            }
+        }
+        for (auto idx : order) {
+            if (startup_abandoned()) return;
+            build_startup_singleton(idx);
+        }
+        impl_->startup->phase_done(k);
+    }
+}
+
+void resolver::build_startup_singleton(std::size_t idx) {
+    const auto& graph = *impl_->graph;
+    const auto& desc = graph.at(idx);
+    if (desc.refreshable) {
+        static_cast<void>(acquire_refreshable_by_index(idx));
+        return;
+    }
+    if (graph.is_inherited(idx) || desc.alias_of || t_factory_depth > 0) {
+        resolve_singleton_by_index(idx);
+        return;
+    }
+
+    impl::claim state;
+    {
+        std::lock_guard lock(impl_->singleton_mutex);
+        state = impl_->claim_build(idx);
+    }
+    if (state == impl::claim::cached) return;
+    if (state == impl::claim::reentered) {
+        resolve_singleton_by_index(idx);
+        return;
+    }
+    // As for parallel collection members: the factory runs without the
+    // cache lock, so get<T>() on other threads is not held up by a slow
+    // phase; its dependencies were built (and cached) before it.  A
+    // concurrent get<T>() waits on the claim instead of building its own.
+    impl::build_claim claim(*impl_, idx, state);
+    auto built = invoke_factory(desc, *this, impl_->watchdog.get());
+    std::lock_guard lock(impl_->singleton_mutex);
+    impl_->singletons.emplace(idx, impl_->cache_entry(idx, std::move(built), *this));
+    impl_->creation_order.push_back(idx);
+}
+
+std::stop_token resolver::construction_stop_token() noexcept {
+    return t_construction_stop.get_token();
+}
+
+std::shared_future<void> resolver::phase_ready(std::string_view phase) const {
+    const auto& phases = impl_->graph->options.startup_phases;
+    auto it = std::find(phases.begin(), phases.end(), phase);
+    if (it == phases.end() || impl_->phase_ready.empty()) {
+        throw di_error("Unknown startup phase \"" + std::string(phase) + "\"");
+    }
+    return impl_->phase_ready[static_cast<std::size_t>(it - phases.begin())];
+}
+
+// ---------------------------------------------------------------
+// Refreshable singletons
+// ---------------------------------------------------------------
+
+std::shared_ptr<void> resolver::acquire_refreshable_by_index(std::size_t idx) {
+    const auto& graph = *impl_->graph;
+    idx = graph.canonical_index(idx);
+    if (graph.is_inherited(idx)) {
+        return impl_->parent->acquire_refreshable_by_index(idx);
+    }
+
+    auto it = impl_->refresh_cells.find(idx);
+    if (it == impl_->refresh_cells.end()) {
+        throw di_error(internal::demangle(graph.at(idx).component_type)
+                       + " is not registered as refreshable or evictable; use get<T>()");
+    }
+    auto& cell = *it->second;
+
+    if (auto current = cell.current.load(std::memory_order_acquire)) {
+        if (cell.evictable) impl_->touch(cell);
+        return current;
+    }
+
+    std::shared_ptr<void> created;
+    {
+        std::lock_guard lock(cell.writer);
+        if (auto current = cell.current.load(std::memory_order_acquire)) {
+            if (cell.evictable) impl_->touch(cell);
+            return current;
+        }
+        created = to_shared(resolve_transient_by_index(idx));
+        if (cell.evictable) {
+            // Account before publishing so a concurrent trim never
+            // subtracts bytes that were not yet added.
+            impl_->resident_bytes.fetch_add(cell.accounted_size, std::memory_order_relaxed);
+            impl_->touch(cell);
+        }
+        cell.current.store(created, std::memory_order_release);
+    }
+
+    auto budget = graph.options.eviction_budget;
+    if (cell.evictable && budget != 0
+        && impl_->resident_bytes.load(std::memory_order_relaxed) > budget) {
+        static_cast<void>(trim_evictable(budget, &cell));
+    }
+    return created;
+}
+
+// ---------------------------------------------------------------
+// Evictable singletons
+// ---------------------------------------------------------------
+
+std::size_t resolver::trim(std::size_t target_bytes) {
+    return trim_evictable(target_bytes, nullptr);
+}
+
+std::size_t resolver::evictable_bytes() const noexcept {
+    return impl_->resident_bytes.load(std::memory_order_relaxed);
+}
+
+std::size_t resolver::trim_evictable(std::size_t target_bytes, const void* keep) {
+    // Declared before the lock: evicted instances are destroyed after the
+    // lock is released, so their destructors may acquire other slots.
+    std::vector<std::shared_ptr<void>> evicted;
+    std::size_t released = 0;
+
+    std::lock_guard lock(impl_->trim_mutex);
+    if (impl_->resident_bytes.load(std::memory_order_relaxed) <= target_bytes) {
+        return 0;
+    }
+
+    // Only handles may refer to an evictable instance (enforced by
+    // validation), so any eviction order is dependency-safe; pick LRU.
+    std::vector<std::pair<std::uint64_t, refresh_cell*>> candidates;
+    for (auto* cell : impl_->evictable_cells) {
+        if (cell != keep && cell->current.load(std::memory_order_acquire)) {
+            candidates.emplace_back(cell->last_use.load(std::memory_order_relaxed), cell);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    for (auto& [last_use, cell] : candidates) {
+        if (impl_->resident_bytes.load(std::memory_order_relaxed) <= target_bytes) break;
+        if (auto previous = cell->current.exchange(nullptr, std::memory_order_acq_rel)) {
+            impl_->resident_bytes.fetch_sub(cell->accounted_size, std::memory_order_relaxed);
+            released += cell->accounted_size;
+            evicted.push_back(std::move(previous));
+        }
+    }
+    return released;
+}
+
+void resolver::refresh_refreshable_by_index(std::size_t idx) {
+    const auto& graph = *impl_->graph;
+    idx = graph.canonical_index(idx);
+    if (graph.is_inherited(idx)) {
+        impl_->parent->refresh_refreshable_by_index(idx);
+        return;
+    }
+
+    auto it = impl_->refresh_cells.find(idx);
+    if (it == impl_->refresh_cells.end() || it->second->evictable) {
+        throw di_error(internal::demangle(graph.at(idx).component_type)
+                       + " is not registered as refreshable");
+    }
+    auto& cell = *it->second;
+
+    std::lock_guard lock(cell.writer);
+    auto replacement = to_shared(resolve_transient_by_index(idx));
+    // The previous instance lives on in outstanding read guards and is
+    // destroyed with the last of them (or right here if there are none).
+    auto previous = cell.current.exchange(replacement, std::memory_order_acq_rel);
+    for (auto& [id, callback] : cell.subscribers) {
+        callback(replacement.get());
+    }
+}
+
+// ---------------------------------------------------------------
+// Singleton families
+// ---------------------------------------------------------------
+
+namespace {
+
+// Sets the key current_family_key() reports while a member is built;
+// restores the outer one for members built from inside its factory.
+class family_key_scope {
+public:
+    explicit family_key_scope(std::string_view key) noexcept
+        : previous_(std::exchange(t_family_key, key)) {}
+    ~family_key_scope() { t_family_key = previous_; }
+
+    family_key_scope(const family_key_scope&) = delete;
+    family_key_scope& operator=(const family_key_scope&) = delete;
+
+private:
+    std::string_view previous_;
+};
+
+} // namespace
+
+std::string_view internal::current_family_key() noexcept {
+    return t_family_key;
+}
+
+std::shared_ptr<void> resolver::resolve_family_by_index(std::size_t idx,
+                                                        const std::string& key) {
+    const auto& graph = *impl_->graph;
+    idx = graph.canonical_index(idx);
+    if (graph.is_inherited(idx)) {
+        return impl_->parent->resolve_family_by_index(idx, key);
+    }
+    const auto& desc = graph.at(idx);
+    auto& cache = *impl_->families.at(idx);
+
+    // Aliases the member, so a guard keeps an evicted instance alive
+    auto pin = [&cache](std::shared_ptr<family_member> member) {
+        cache.touch(*member);
+        void* instance = member->instance.get();
+        return std::shared_ptr<void>(std::move(member), instance);
+    };
+
+    if (auto hit = cache.find(key)) return pin(std::move(hit));
+
+    // Declared before the lock: an evicted member is destroyed after it is
+    // released (unless a guard still pins it)
+    std::shared_ptr<family_member> evicted;
+    std::unique_lock lock(impl_->singleton_mutex);
+    auto state = impl_->claim_member(cache, key);
+    if (state == impl::claim::cached) return pin(cache.find(key));
+    impl::member_claim claim(*impl_, cache, key, state);
+
+    // Only this key is claimed: the factory runs without this frame's hold
+    // on the singleton lock, so members under other keys are built
+    // meanwhile, and its own dependencies go through the usual locked path.
+    auto member = std::make_shared<family_member>();
+    member->key = key;
+    lock.unlock();
+    {
+        family_key_scope scope(key);
+        member->instance = impl_->wrap_toggled(
+            idx, invoke_factory(desc, *this, impl_->watchdog.get()), *this);
+    }
+    lock.lock();
+
+    // Built again further down this thread's stack (a cycle through the
+    // family): keep the first
+    if (auto hit = cache.find(key)) return pin(std::move(hit));
+    evicted = cache.insert(member);
+    if (!cache.listed) {
+        // Its dependencies were created (and listed) by the factory above,
+        // so teardown destroys the family before them
+        cache.listed = true;
+        impl_->creation_order.push_back(idx);
+    }
+    return pin(std::move(member));
+}
+
+// get<T>(key) / keyed<T, Key>: a member that lives as long as the family
+void* resolver::resolve_family_member(std::size_t idx, const std::string& key) {
+    const auto& desc = impl_->graph->at(idx);
+    if (desc.family_capacity != 0) {
+        throw di_error(internal::demangle(desc.component_type)
+                       + " is a capped singleton family whose members may be evicted;"
+                         " use acquire<T>(key)");
+    }
+    return resolve_family_by_index(idx, key).get();
+}
+
+// ---------------------------------------------------------------
+// Toggleable decorators
+// ---------------------------------------------------------------
+
+std::size_t resolver::set_decorator_enabled_impl(std::type_index type,
+                                                 const std::string* key,
+                                                 std::type_index decorator,
+                                                 bool enabled) {
+    std::lock_guard lock(impl_->singleton_mutex);
+    std::size_t affected = 0;
+    for (auto idx : impl_->toggled) {
+        const auto& desc = impl_->graph->at(idx);
+        if (desc.component_type != type || (key && desc.key != *key)) continue;
+
+        auto& flags = impl_->toggle_flags.at(idx);
+        bool matches = false;
+        std::vector<std::size_t> changed;
+        for (std::size_t i = 0; i < desc.toggles.size(); ++i) {
+            if (desc.toggles[i].decorator_type != decorator) continue;
+            matches = true;
+            if (flags[i].exchange(enabled, std::memory_order_acq_rel) != enabled) {
+                changed.push_back(i);
+            }
+        }
+        if (!matches) continue;
+        ++affected;
+
+        // Singletons already created here switch their exposed instance;
+        // inherited ones live in the parent and keep its state
+        auto it = impl_->singletons.find(idx);
+        if (changed.empty() || it == impl_->singletons.end()) continue;
+        try {
+            static_cast<toggle_holder*>(it->second.get())
+                ->select(desc, impl_->toggle_mask(idx), *this);
+        } catch (...) {
+            for (auto i : changed) flags[i].store(!enabled, std::memory_order_release);
+            throw;
+        }
+    }
+    return affected;
+}
+
+std::shared_ptr<void> resolver::acquire_refreshable_impl(std::type_index type,
+                                                         const std::string& key) {
+    const auto* indices = impl_->find_slot(type, key, lifetime_kind::singleton, false);
+    if (!indices && !key.empty()) {
+        // No registration of its own: a member of T's family, if any
+        indices = impl_->find_slot(type, {}, lifetime_kind::singleton, false);
+        if (!indices || !impl_->graph->at(indices->front()).family) return nullptr;
+        return resolve_family_by_index(indices->front(), key);
+    }
+    if (!indices) return nullptr;
+    return acquire_refreshable_by_index(indices->front());
+}
+
+bool resolver::refresh_refreshable_impl(std::type_index type, const std::string& key) {
+    const auto* indices = impl_->find_slot(type, key, lifetime_kind::singleton, false);
+    if (!indices) return false;
+    refresh_refreshable_by_index(indices->front());
+    return true;
+}
+
+refresh_subscription resolver::subscribe_refresh_impl(std::type_index type,
+                                                      const std::string& key,
+                                                      std::function<void(void*)> callback) {
+    const auto* indices = impl_->find_slot(type, key, lifetime_kind::singleton, false);
+    if (!indices) {
+        throw not_found(type, key, slot_hint(type, key, "on_refresh<T>()"));
+    }
+
+    auto* self = this;
+    std::size_t idx = impl_->graph->canonical_index(indices->front());
+    while (self->impl_->graph->is_inherited(idx)) {
+        self = self->impl_->parent.get();
+    }
+
+    auto it = self->impl_->refresh_cells.find(idx);
+    if (it == self->impl_->refresh_cells.end() || it->second->evictable) {
+        throw di_error(internal::demangle(type) + " is not registered as refreshable");
+    }
+
+    std::shared_ptr<refresh_cell> cell = it->second;
+    std::size_t id = 0;
+    {
+        std::lock_guard lock(cell->writer);
+        id = cell->next_subscriber++;
+        cell->subscribers.emplace_back(id, std::move(callback));
+    }
+
+    return refresh_subscription([weak = std::weak_ptr<refresh_cell>(cell), id] {
+        if (auto c = weak.lock()) {
+            std::lock_guard lock(c->writer);
+            std::erase_if(c->subscribers, [id](const auto& entry) { return entry.first == id; });
+        }
+    });
+}
+
+// ---------------------------------------------------------------
+// Non-template core: batch resolution (get_many)
+// ---------------------------------------------------------------
+
+std::size_t resolver::next_batch_plan_id() noexcept {
+    static std::atomic<std::size_t> next{0};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+void resolver::resolve_batch_impl(std::size_t plan_id,
+                                  const dependency_info* deps,
+                                  batch_slot* out,
+                                  std::size_t count) {
+    const auto* plan = impl_->batch_plans.find(plan_id);
+    if (!plan) {
+        // Only reads the immutable graph, so no lock.  The whole plan is
+        // checked before it is cached, so a failed exact<I, TImpl> check is
+        // reported again on the next call.
+        auto built = std::make_unique<batch_plan>();
+        built->slots.reserve(count);
+        built->missing = count;
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto& dep = deps[i];
+            const auto* indices = dep.is_refreshable
+                ? nullptr
+                : impl_->graph->dependency_slot(dep);
+            if (dep.exact_impl && indices) {
+                impl_->check_exact(indices->front(), dep.type, *dep.exact_impl);
+            }
+            if (!indices && !dep.is_refreshable && !dep.is_collection
+                && built->missing == count) {
+                built->missing = i;
+            }
+            built->locked = built->locked || (!dep.is_refreshable && !dep.is_transient);
+            built->slots.push_back(indices);
+        }
+        plan = impl_->batch_plans.publish(plan_id, std::move(built));
+    }
+
+    if (plan->missing < count) {
+        const auto& dep = deps[plan->missing];
+        const char* method = dep.key.empty()
+            ? (dep.is_transient ? "create<T>()" : "get<T>()")
+            : (dep.is_transient ? "create<T>(key)" : "get<T>(key)");
+        throw not_found(dep.type, dep.key, slot_hint(dep.type, dep.key, method));
+    }
+
+    // Singleton slots first, under one acquisition of the lock.  Factories
+    // that resolve further dependencies re-enter it on this thread.
+    if (plan->locked) {
+        std::lock_guard lock(impl_->singleton_mutex);
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto& dep = deps[i];
+            if (dep.is_refreshable || dep.is_transient) continue;
+            const auto* indices = plan->slots[i];
+            if (!dep.is_collection) {
+                if (!dep.key.empty() && impl_->graph->at(indices->front()).family) {
+                    out[i].single = resolve_family_member(indices->front(), dep.key);
+                } else {
+                    out[i].single = resolve_singleton_locked(indices->front());
+                }
+            } else if (indices) {
+                out[i].many.reserve(indices->size());
+                for (auto idx : *indices) {
+                    out[i].many.push_back(resolve_singleton_locked(idx));
+                }
+            }
+        }
+    }
+
+    // Transients need no lock and are built after it is released, so
+    // cached get<T>() calls on other threads are not held up by them
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& dep = deps[i];
+        if (dep.is_refreshable || !dep.is_transient) continue;
+        const auto* indices = plan->slots[i];
+        if (!dep.is_collection) {
+            out[i].owned = resolve_transient_by_index(indices->front());
+        } else if (indices) {
+            out[i].owned_many.reserve(indices->size());
+            for (auto idx : *indices) {
+                out[i].owned_many.push_back(resolve_transient_by_index(idx));
+            }
         }
-        throw;
-    } catch (const std::exception& e) {
-        auto ex = resolution_error(desc.component_type, e,
-                               desc.registration_location,
-                               std::source_location::current());
-        ex.set_diagnostic_detail(
-            internal::format_registration_trace(desc));
-        throw ex;
     }
 }
 
@@ -316,11 +2074,26 @@ erased_ptr resolver::resolve_transient_by_index(std::size_t idx) {
 
 void* resolver::get_singleton_impl(std::type_index type, const std::string& key) {
     const auto* indices = impl_->find_slot(type, key, lifetime_kind::singleton, false);
+    if (!indices && !key.empty()) {
+        // No registration of its own: a member of T's family, if any
+        indices = impl_->find_slot(type, {}, lifetime_kind::singleton, false);
+        if (!indices) return nullptr;
+        if (!impl_->graph->at(indices->front()).family) return nullptr;
+        return resolve_family_member(indices->front(), key);
+    }
     if (!indices || indices->empty()) return nullptr;
     // Single-instance slot — should have exactly 1 entry
     return resolve_singleton_by_index(indices->front());
 }
 
+void* resolver::get_exact_impl(std::type_index type, const std::string& key,
+                               std::type_index impl_type) {
+    const auto* indices = impl_->find_slot(type, key, lifetime_kind::singleton, false);
+    if (!indices || indices->empty()) return nullptr;
+    impl_->check_exact(indices->front(), type, impl_type);
+    return resolve_singleton_by_index(indices->front());
+}
+
 // ---------------------------------------------------------------
 // Non-template core: create transient
 // ---------------------------------------------------------------
@@ -336,10 +2109,15 @@ erased_ptr resolver::create_transient_impl(std::type_index type, const std::stri
 // ---------------------------------------------------------------
 
 std::vector<void*> resolver::get_collection_impl(std::type_index type,
-                                                  const std::string& key) {
+                                                  const std::string& key,
+                                                  const task_executor* executor) {
     const auto* indices = impl_->find_slot(type, key, lifetime_kind::singleton, true);
     if (!indices) return {};
 
+    if (const auto* ex = pick_executor(executor); ex && indices->size() > 1) {
+        create_members_in_parallel(*indices, *ex);
+    }
+
     std::vector<void*> result;
     result.reserve(indices->size());
     for (auto idx : *indices) {
@@ -353,11 +2131,24 @@ std::vector<void*> resolver::get_collection_impl(std::type_index type,
 // ---------------------------------------------------------------
 
 std::vector<erased_ptr> resolver::create_collection_impl(std::type_index type,
-                                                          const std::string& key) {
+                                                          const std::string& key,
+                                                          const task_executor* executor) {
     const auto* indices = impl_->find_slot(type, key, lifetime_kind::transient, true);
     if (!indices) return {};
 
     std::vector<erased_ptr> result;
+    const auto* ex = pick_executor(executor);
+    if (ex && indices->size() > 1 && t_factory_depth == 0) {
+        // Transient members never share instances: build all at once
+        result.resize(indices->size());
+        if (auto error = run_on_executor(*ex, indices->size(), [&](std::size_t i) {
+                result[i] = resolve_transient_by_index((*indices)[i]);
+            })) {
+            std::rethrow_exception(error);
+        }
+        return result;
+    }
+
     result.reserve(indices->size());
     for (auto idx : *indices) {
         result.push_back(resolve_transient_by_index(idx));
@@ -365,6 +2156,75 @@ std::vector<erased_ptr> resolver::create_collection_impl(std::type_index type,
     return result;
 }
 
+// ---------------------------------------------------------------
+// Parallel construction of singleton collection members
+// ---------------------------------------------------------------
+
+const task_executor* resolver::pick_executor(const task_executor* executor) const noexcept {
+    if (executor && *executor) return executor;
+    const auto& fallback = impl_->graph->options.collection_executor;
+    return fallback ? &fallback : nullptr;
+}
+
+void resolver::create_members_in_parallel(const std::vector<std::size_t>& members,
+                                          const task_executor& executor) {
+    // Inside a factory this thread may hold the singleton lock that the
+    // workers would need; the caller then resolves sequentially.
+    if (t_factory_depth > 0) return;
+
+    const auto& graph = *impl_->graph;
+    const std::vector<std::vector<std::size_t>>* waves = nullptr;
+    {
+        std::lock_guard lock(impl_->singleton_mutex);
+        auto [it, inserted] = impl_->collection_waves.try_emplace(&members);
+        if (inserted) it->second = member_waves(graph, members);
+        waves = &it->second;
+    }
+
+    for (const auto& wave : *waves) {
+        // Claimed members are built here and nowhere else: other threads
+        // resolving one wait for it.  Members claimed elsewhere are left to
+        // the sequential resolution, which waits the same way.
+        std::vector<std::size_t> pending;
+        std::vector<std::unique_ptr<impl::build_claim>> claims;
+        {
+            std::lock_guard lock(impl_->singleton_mutex);
+            for (auto pos : wave) {
+                auto idx = graph.canonical_index(members[pos]);
+                const auto& desc = graph.at(idx);
+                if (graph.is_inherited(idx) || desc.refreshable || desc.evictable
+                    || desc.alias_of || impl_->singletons.count(idx) != 0
+                    || impl_->building.count(idx) != 0) {
+                    continue;
+                }
+                claims.push_back(std::make_unique<impl::build_claim>(
+                    *impl_, idx, impl_->claim_build(idx)));
+                pending.push_back(idx);
+            }
+        }
+        if (pending.size() < 2) continue;   // sequential resolution covers it
+
+        // Factories run without the singleton lock; their own dependencies
+        // are resolved (and cached) through the usual locked path.
+        std::vector<erased_ptr> built(pending.size());
+        auto error = run_on_executor(executor, pending.size(), [&](std::size_t i) {
+            built[i] = invoke_factory(graph.at(pending[i]), *this, impl_->watchdog.get());
+        });
+
+        {
+            std::lock_guard lock(impl_->singleton_mutex);
+            for (std::size_t i = 0; i < pending.size(); ++i) {
+                if (!built[i]) continue;   // failed; the error is rethrown below
+                impl_->singletons.emplace(pending[i],
+                    impl_->cache_entry(pending[i], std::move(built[i]), *this));
+                impl_->creation_order.push_back(pending[i]);
+            }
+        }
+        claims.clear();
+        if (error) std::rethrow_exception(error);
+    }
+}
+
 // ---------------------------------------------------------------
 // Diagnostic: slot hint for better not_found messages
 // ---------------------------------------------------------------
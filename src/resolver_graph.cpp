@@ -0,0 +1,174 @@
+#include "resolver_graph.hpp"
+
+#include <algorithm>
+#include <set>
+#include <utility>
+
+namespace librtdi::internal {
+
+namespace {
+
+slot_key slot_of(const descriptor& d) {
+    return slot_key(d.component_type, d.key, d.lifetime, d.is_collection);
+}
+
+} // namespace
+
+// Index descriptor `idx` of this graph: its slot, toggles, deadlines and
+// the slots its dependencies look up.
+void resolver_graph::index_descriptor(std::size_t idx) {
+    const auto& d = descriptors[idx - base];
+    slot_to_indices[slot_of(d)].push_back(idx);
+    if (!d.toggles.empty()) {
+        toggled_indices.push_back(idx);
+    }
+    any_deadline = any_deadline || d.deadline != construction_deadline{};
+    any_hard_deadline = any_hard_deadline || d.deadline.hard.count() != 0;
+
+    for (const auto& dep : d.dependencies) {
+        auto lt = dep.is_transient ? lifetime_kind::transient : lifetime_kind::singleton;
+        dependents[slot_key(dep.type, dep.key, lt, dep.is_collection)].push_back(idx);
+        if (!dep.key.empty() && !dep.is_transient && !dep.is_collection) {
+            dependents[slot_key(dep.type, std::string{}, lifetime_kind::singleton, false)]
+                .push_back(idx);
+        }
+    }
+}
+
+// ---------------------------------------------------------------
+// Root graph (compiled from a registry)
+// ---------------------------------------------------------------
+
+resolver_graph::resolver_graph(std::vector<descriptor> descs, const build_options& opts)
+    : descriptors(std::move(descs))
+    , options(opts)
+{
+    for (std::size_t i = 0; i < descriptors.size(); ++i) {
+        index_descriptor(i);
+        if (descriptors[i].lifetime == lifetime_kind::singleton) {
+            singleton_list_for(descriptors[i]).push_back(i);
+        }
+    }
+
+    dependency_slots.reserve(descriptors.size());
+    for (const auto& d : descriptors) {
+        auto& bound = dependency_slots.emplace_back();
+        for (const auto& dep : d.dependencies) bound.push_back(dependency_slot(dep));
+    }
+}
+
+// ---------------------------------------------------------------
+// Child graph (parent tables + overriding descriptors)
+//
+// The parent is shared unchanged; everything built here is proportional
+// to the overrides and to the parent entries that depend on them.
+// ---------------------------------------------------------------
+
+resolver_graph::resolver_graph(std::shared_ptr<const resolver_graph> base_graph,
+                               std::vector<descriptor> overrides,
+                               const build_options& opts)
+    : parent(std::move(base_graph))
+    , descriptors(std::move(overrides))
+    , base(parent->size())
+    , any_deadline(parent->any_deadline)
+    , any_hard_deadline(parent->any_hard_deadline)
+    , canonical(parent->canonical)
+    , shadowed(parent->shadowed)
+    , options(opts)
+{
+    for (std::size_t i = 0; i < descriptors.size(); ++i) {
+        index_descriptor(base + i);
+    }
+
+    // ① Own slots replace the parent's wholesale.  Parent factories (e.g.
+    //    forwards) that captured a shadowed single-slot index are redirected
+    //    to the overriding descriptor so they observe the override as well.
+    std::unordered_map<std::size_t, std::size_t> redirect;
+    for (const auto& [sk, indices] : slot_to_indices) {
+        const auto* replaced = parent->find_slot(sk);
+        if (!replaced) continue;
+        for (auto old_idx : *replaced) {
+            shadowed.insert(old_idx);
+            tainted.insert(old_idx);
+            if (!std::get<3>(sk)) redirect.emplace(old_idx, indices.front());
+        }
+    }
+    for (auto& [idx, target] : canonical) {
+        if (auto it = redirect.find(target); it != redirect.end()) target = it->second;
+    }
+    for (const auto& [old_idx, target] : redirect) {
+        canonical.emplace(old_idx, target);
+    }
+
+    dependency_slots.reserve(descriptors.size());
+    for (const auto& d : descriptors) {
+        auto& bound = dependency_slots.emplace_back();
+        for (const auto& dep : d.dependencies) bound.push_back(dependency_slot(dep));
+    }
+
+    // ② A parent entry can be shared with the parent resolver unless it was
+    //    shadowed or (transitively) depends on an own slot.  Only entries
+    //    that look up a slot touched so far are visited: the reverse
+    //    dependency closure of the overrides.
+    std::vector<slot_key> pending;
+    std::set<slot_key> touched;
+    for (const auto& [sk, indices] : slot_to_indices) {
+        touched.insert(sk);
+        pending.push_back(sk);
+    }
+
+    auto depends_on_override = [&](const std::vector<const std::vector<std::size_t>*>& bound) {
+        return std::any_of(bound.begin(), bound.end(), [&](const auto* slot) {
+            return slot && std::any_of(slot->begin(), slot->end(), [&](std::size_t j) {
+                return j >= base || tainted.contains(j);
+            });
+        });
+    };
+
+    while (!pending.empty()) {
+        auto sk = std::move(pending.back());
+        pending.pop_back();
+        for (const auto* g = parent.get(); g; g = g->parent.get()) {
+            auto it = g->dependents.find(sk);
+            if (it == g->dependents.end()) continue;
+            for (auto idx : it->second) {
+                if (tainted.contains(idx) || shadowed.contains(idx)) continue;
+
+                // The dependencies of `idx` may bind to an own slot now
+                const auto& inherited_binding = parent->bound_dependencies(idx);
+                const auto& deps = at(idx).dependencies;
+                std::vector<const std::vector<std::size_t>*> bound;
+                bound.reserve(deps.size());
+                for (const auto& dep : deps) bound.push_back(dependency_slot(dep));
+                if (bound != inherited_binding) {
+                    rebound.insert_or_assign(idx, bound);
+                }
+
+                if (!depends_on_override(bound)) continue;
+                tainted.insert(idx);
+                auto own_key = slot_of(at(idx));
+                if (touched.insert(own_key).second) pending.push_back(std::move(own_key));
+            }
+        }
+    }
+
+    // ③ Entries this graph's resolvers create: the overrides and the
+    //    re-created (tainted, live) parent entries, in index order
+    for (auto idx : tainted) {
+        const auto& d = at(idx);
+        if (d.lifetime == lifetime_kind::singleton && !shadowed.contains(idx)) {
+            singleton_list_for(d).push_back(idx);
+        }
+    }
+    for (std::size_t i = 0; i < descriptors.size(); ++i) {
+        if (descriptors[i].lifetime == lifetime_kind::singleton) {
+            singleton_list_for(descriptors[i]).push_back(base + i);
+        }
+    }
+    std::sort(singleton_indices.begin(), singleton_indices.end());
+    std::sort(refreshable_indices.begin(), refreshable_indices.end());
+    std::sort(evictable_indices.begin(), evictable_indices.end());
+    std::sort(family_indices.begin(), family_indices.end());
+}
+
+} // namespace librtdi::internal
@@ -0,0 +1,208 @@
+#pragma once
+
+// Internal immutable descriptor tables shared between a compiled_graph and
+// every resolver instantiated from it.
+// This header is NOT installed — it is only used by the library's .cpp files.
+
+#include "librtdi/descriptor.hpp"
+#include "librtdi/exceptions.hpp"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <typeindex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace librtdi::internal {
+
+// ---------------------------------------------------------------
+// Slot key: (type, key, lifetime, is_collection) → identifies a slot
+// ---------------------------------------------------------------
+
+using slot_key = std::tuple<std::type_index, std::string, lifetime_kind, bool>;
+using slot_map = std::map<slot_key, std::vector<std::size_t>>;
+
+// Slot a declared dependency resolves from, or null if unregistered: its
+// (type, key, lifetime, collection) slot or, for a keyed single singleton
+// with no registration of its own, the type's singleton family.  `graph`
+// provides find_slot(slot_key) and at(index).
+template <typename Graph>
+const std::vector<std::size_t>* find_dependency_slot(const Graph& graph,
+                                                     const dependency_info& dep) {
+    auto lt = dep.is_transient ? lifetime_kind::transient : lifetime_kind::singleton;
+    if (const auto* slot = graph.find_slot(slot_key(dep.type, dep.key, lt, dep.is_collection))) {
+        return slot;
+    }
+    if (dep.key.empty() || dep.is_transient || dep.is_collection) return nullptr;
+
+    const auto* family = graph.find_slot(
+        slot_key(dep.type, std::string{}, lifetime_kind::singleton, false));
+    if (!family || !graph.at(family->front()).family) return nullptr;
+    return family;
+}
+
+// Why the single-slot entry at `idx` cannot be handed out as `impl` by
+// exact<I, TImpl> / get_exact(); empty when it can.  Forward aliases are
+// checked through to the descriptor that owns the instance.
+template <typename Graph>
+std::string exact_binding_error(const Graph& graph, std::size_t idx, std::type_index impl) {
+    const descriptor* d = &graph.at(idx);
+    for (;;) {
+        if (d->decorated) {
+            return "slot is decorated, so its instance is not a plain " + demangle(impl);
+        }
+        if (!d->alias_of) break;
+        d = &graph.at(*d->alias_of);
+    }
+    if (d->impl_type != impl) {
+        return "slot is bound to " +
+               (d->impl_type ? demangle(*d->impl_type) : std::string("a factory")) +
+               ", not " + demangle(impl);
+    }
+    return {};
+}
+
+struct resolver_graph {
+    // Overlay base of a child graph; null for graphs compiled from a registry.
+    std::shared_ptr<const resolver_graph> parent;
+
+    // Descriptors owned by this graph.  They occupy indices [base, size()),
+    // after every parent entry, so indices captured by a parent's factories
+    // stay valid.  Lower indices are looked up in the parent, which is
+    // shared as is: a child copies none of its tables.
+    std::vector<descriptor> descriptors;
+    std::size_t base = 0;
+
+    // Index: slot_key → list of descriptor indices in that slot.  A child
+    // indexes only its overrides; each replaces the parent's slot wholesale,
+    // so a key it does not hold is looked up in the parent.
+    slot_map slot_to_indices;
+
+    // Declared dependencies of this graph's descriptors, bound to their slots
+    // when the graph is built (find_dependency_slot; null = unregistered).
+    // Indexed by index - base, then by declaration order.
+    std::vector<std::vector<const std::vector<std::size_t>*>> dependency_slots;
+
+    // Reverse dependency index: slot_key a dependency looks up → this
+    // graph's descriptors declaring it.  Keyed single singletons are also
+    // listed under their type's family slot, which they may fall back to.
+    slot_map dependents;
+
+    // Singleton descriptor indices this graph's resolvers create, in
+    // registration order (eager creation): a child lists its overrides and
+    // the parent entries it re-creates, not those it shares.  Refreshable
+    // and evictable singletons, which live in swappable cells, and
+    // singleton families, which are never eager, are listed separately.
+    std::vector<std::size_t> singleton_indices;
+    std::vector<std::size_t> refreshable_indices;
+    std::vector<std::size_t> evictable_indices;
+    std::vector<std::size_t> family_indices;
+
+    // This graph's descriptors with toggleable decorators (any lifetime);
+    // see for_each_toggled() for every level.
+    std::vector<std::size_t> toggled_indices;
+
+    // Some descriptor of this graph or a parent has a construction deadline
+    // (a hard one).
+    bool any_deadline = false;
+    bool any_hard_deadline = false;
+
+    // Child graphs only, keyed by parent index and holding just the entries
+    // the overrides affect:
+    //  - canonical: a shadowed single-slot entry → the overriding index,
+    //    composed over every level
+    //  - shadowed: entries of replaced slots, over every level
+    //  - tainted: entries that (transitively) depend on an override, so the
+    //    parent resolver's instance cannot be shared
+    //  - rebound: entries whose dependencies bind differently here
+    std::unordered_map<std::size_t, std::size_t> canonical;
+    std::unordered_set<std::size_t> shadowed;
+    std::unordered_set<std::size_t> tainted;
+    std::unordered_map<std::size_t, std::vector<const std::vector<std::size_t>*>> rebound;
+
+    build_options options;
+
+    resolver_graph(std::vector<descriptor> descs, const build_options& opts);
+
+    // Child graph: `overrides` replace the parent's slots they occupy.
+    resolver_graph(std::shared_ptr<const resolver_graph> base_graph,
+                   std::vector<descriptor> overrides,
+                   const build_options& opts);
+
+    std::size_t size() const noexcept { return base + descriptors.size(); }
+
+    std::vector<std::size_t>& singleton_list_for(const descriptor& d) {
+        if (d.refreshable) return refreshable_indices;
+        if (d.evictable) return evictable_indices;
+        if (d.family) return family_indices;
+        return singleton_indices;
+    }
+
+    const descriptor& at(std::size_t idx) const {
+        const auto* g = this;
+        while (idx < g->base) g = g->parent.get();
+        return g->descriptors[idx - g->base];
+    }
+
+    const std::vector<const std::vector<std::size_t>*>& bound_dependencies(std::size_t idx) const {
+        const auto* g = this;
+        while (idx < g->base) {
+            if (auto it = g->rebound.find(idx); it != g->rebound.end()) return it->second;
+            g = g->parent.get();
+        }
+        return g->dependency_slots[idx - g->base];
+    }
+
+    const std::vector<std::size_t>* dependency_slot(const dependency_info& dep) const {
+        return find_dependency_slot(*this, dep);
+    }
+
+    std::size_t canonical_index(std::size_t idx) const noexcept {
+        if (canonical.empty()) return idx;
+        auto it = canonical.find(idx);
+        return it == canonical.end() ? idx : it->second;
+    }
+
+    bool is_inherited(std::size_t idx) const {
+        return idx < base && !tainted.contains(idx)
+            && at(idx).lifetime == lifetime_kind::singleton;
+    }
+
+    const std::vector<std::size_t>* find_slot(const slot_key& sk) const {
+        for (const auto* g = this; g; g = g->parent.get()) {
+            auto it = g->slot_to_indices.find(sk);
+            if (it == g->slot_to_indices.end()) continue;
+            return it->second.empty() ? nullptr : &it->second;
+        }
+        return nullptr;
+    }
+
+    const std::vector<std::size_t>* find_slot(std::type_index type,
+                                              const std::string& key,
+                                              lifetime_kind lt,
+                                              bool is_coll) const {
+        return find_slot(slot_key(type, key, lt, is_coll));
+    }
+
+    // Calls fn(idx) for every live descriptor with toggleable decorators,
+    // parent levels first.
+    template <typename Fn>
+    void for_each_toggled(Fn&& fn) const {
+        std::vector<const resolver_graph*> levels;
+        for (const auto* g = this; g; g = g->parent.get()) levels.push_back(g);
+        for (auto level = levels.rbegin(); level != levels.rend(); ++level) {
+            for (auto idx : (*level)->toggled_indices) {
+                if (!shadowed.contains(idx)) fn(idx);
+            }
+        }
+    }
+
+private:
+    void index_descriptor(std::size_t idx);
+};
+
+} // namespace librtdi::internal
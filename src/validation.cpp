@@ -1,43 +1,66 @@
 #include "librtdi/descriptor.hpp"
 #include "librtdi/exceptions.hpp"
+#include "resolver_graph.hpp"
 #include "stacktrace_utils.hpp"
 
 #include <algorithm>
 #include <map>
 #include <set>
 #include <source_location>
+#include <string>
 #include <tuple>
 #include <typeindex>
+#include <utility>
 #include <vector>
 
 namespace librtdi {
 
-// slot_key = (type, key, lifetime, is_collection)
-using slot_key = std::tuple<std::type_index, std::string,
-                            lifetime_kind, bool>;
+using internal::slot_key;
+using internal::slot_map;
+using descriptor_table = std::vector<const descriptor*>;
 
 namespace {
 
-// Build an index from slot_key → list of descriptor indices
-auto build_slot_index(const std::vector<descriptor>& descriptors) {
-    std::map<slot_key, std::vector<std::size_t>> idx;
-    for (std::size_t i = 0; i < descriptors.size(); ++i) {
-        auto& d = descriptors[i];
-        idx[{d.component_type, d.key, d.lifetime, d.is_collection}]
-            .push_back(i);
+// Registry validation runs before the graph is built: a flat descriptor
+// table with its slot index, read like a resolver_graph
+struct flat_graph {
+    descriptor_table table;
+    slot_map slots;
+
+    explicit flat_graph(const std::vector<descriptor>& descriptors) {
+        table.reserve(descriptors.size());
+        for (std::size_t i = 0; i < descriptors.size(); ++i) {
+            const auto& d = descriptors[i];
+            table.push_back(&d);
+            slots[{d.component_type, d.key, d.lifetime, d.is_collection}].push_back(i);
+        }
     }
-    return idx;
-}
+
+    std::size_t size() const noexcept { return table.size(); }
+    const descriptor& at(std::size_t idx) const { return *table[idx]; }
+
+    const std::vector<std::size_t>* find_slot(const slot_key& sk) const {
+        auto it = slots.find(sk);
+        if (it == slots.end() || it->second.empty()) return nullptr;
+        return &it->second;
+    }
+
+    const std::vector<std::size_t>* dependency_slot(const dependency_info& dep) const {
+        return internal::find_dependency_slot(*this, dep);
+    }
+};
 
 // ------------------------------------------------------------------
 // Check that every dependency_info has a matching slot
 // ------------------------------------------------------------------
+template <typename Graph>
 void check_missing_dependencies(
-        const std::vector<descriptor>& descriptors,
-        const std::map<slot_key, std::vector<std::size_t>>& slot_idx,
+        const descriptor_table& checked,
+        const Graph& graph,
         const build_options& options,
         std::source_location loc) {
-    for (auto& desc : descriptors) {
+    for (const auto* d : checked) {
+        const auto& desc = *d;
         for (auto& dep : desc.dependencies) {
             // Collection dependencies are implicitly optional when
             // allow_empty_collections is true (the industry default).
@@ -46,13 +69,7 @@ void check_missing_dependencies(
             // here keeps build-time validation consistent with runtime.
             if (dep.is_collection && options.allow_empty_collections)
                 continue;
-            auto needed_lt = dep.is_transient ? lifetime_kind::transient
-                                              : lifetime_kind::singleton;
-            slot_key needed{dep.type, "" /* deps always empty key */,
-                            needed_lt, dep.is_collection};
-
-            auto it = slot_idx.find(needed);
-            if (it == slot_idx.end() || it->second.empty()) {
+            if (!graph.dependency_slot(dep)) {
                 // Build a diagnostic hint telling the user which consumer
                 // requires this missing dependency.
                 std::string hint = "required by "
@@ -71,7 +88,7 @@ void check_missing_dependencies(
                         + std::string(desc.registration_location.file_name())
                         + ":" + std::to_string(desc.registration_location.line());
                 }
-                auto ex = not_found(dep.type, std::string_view{}, hint, loc);
+                auto ex = not_found(dep.type, dep.key, hint, loc);
                 ex.set_diagnostic_detail(
                     internal::format_registration_trace(desc));
                 throw ex;
@@ -83,9 +100,10 @@ void check_missing_dependencies(
 // ------------------------------------------------------------------
 // Lifetime validation (captive dependency check)
 // ------------------------------------------------------------------
-void check_lifetime_rules(const std::vector<descriptor>& descriptors,
+void check_lifetime_rules(const descriptor_table& descriptors,
                           std::source_location loc) {
-    for (auto& desc : descriptors) {
+    for (const auto* d : descriptors) {
+        const auto& desc = *d;
         if (desc.lifetime != lifetime_kind::singleton) continue;
 
         for (auto& dep : desc.dependencies) {
@@ -104,32 +122,120 @@ void check_lifetime_rules(const std::vector<descriptor>& descriptors,
     }
 }
 
+// ------------------------------------------------------------------
+// Refreshable and evictable slots: a plain reference would pin a stale
+// (or destroyed) instance, so they may only be injected through a handle
+// (refreshable<T> / evictable<T>) and handles only bind to such slots.
+// A singleton family only injects through keyed<T, Key>, and only while
+// uncapped: an evicted member would leave the reference dangling.
+// ------------------------------------------------------------------
+std::string_view handle_lifetime_name(const descriptor& d) {
+    if (d.family) return "singleton family";
+    if (d.refreshable) return "refreshable";
+    if (d.evictable) return "evictable";
+    return to_string(d.lifetime);
+}
+
+template <typename Graph>
+void check_refreshable_deps(const descriptor_table& checked,
+                            const Graph& graph,
+                            std::source_location loc) {
+    for (const auto* d : checked) {
+        const auto& desc = *d;
+        for (auto& dep : desc.dependencies) {
+            if (dep.is_transient || dep.is_collection) continue;
+
+            const auto* slot = graph.dependency_slot(dep);
+            if (!slot) continue;
+
+            const auto& target = graph.at(slot->front());
+            bool target_handle = target.refreshable || target.evictable;
+            if (target.family) {
+                bool member = !dep.key.empty() && target.family_capacity == 0;
+                if (member && !dep.is_refreshable) continue;
+            } else if (target_handle == dep.is_refreshable) {
+                continue;
+            }
+
+            auto ex = lifetime_mismatch(
+                desc.component_type,
+                handle_lifetime_name(desc),
+                dep.type,
+                target_handle || target.family ? handle_lifetime_name(target)
+                                               : "plain singleton",
+                desc.impl_type, loc);
+            ex.set_diagnostic_detail(internal::format_registration_trace(desc));
+            throw ex;
+        }
+    }
+}
+
+// ------------------------------------------------------------------
+// exact<I, TImpl> dependencies must name the implementation actually
+// bound to I's singleton slot, undecorated
+// ------------------------------------------------------------------
+template <typename Graph>
+void check_exact_deps(const descriptor_table& checked,
+                      const Graph& graph,
+                      std::source_location loc) {
+    for (const auto* d : checked) {
+        const auto& desc = *d;
+        for (auto& dep : desc.dependencies) {
+            if (!dep.exact_impl) continue;
+
+            const auto* slot = graph.dependency_slot(dep);
+            if (!slot) continue;
+
+            auto reason = internal::exact_binding_error(graph, slot->front(),
+                                                        *dep.exact_impl);
+            if (reason.empty()) continue;
+
+            std::string msg = "exact<" + internal::demangle(dep.type) + ", "
+                + internal::demangle(*dep.exact_impl) + "> required by "
+                + internal::demangle(desc.component_type);
+            if (desc.impl_type.has_value()) {
+                msg += " [impl: " + internal::demangle(desc.impl_type.value()) + "]";
+            }
+            auto ex = di_error(msg + ": " + reason, loc);
+            ex.set_diagnostic_detail(internal::format_registration_trace(desc));
+            throw ex;
+        }
+    }
+}
+
 // ------------------------------------------------------------------
 // Cycle detection (DFS on component dependency graph)
 // ------------------------------------------------------------------
 enum class visit_state { unvisited, in_progress, done };
 
-void dfs(std::type_index node, bool is_collection, bool is_transient,
-         const std::map<slot_key, std::vector<std::size_t>>& slot_idx,
-         const std::vector<descriptor>& descriptors,
-         std::map<std::type_index, visit_state>& states,
-         std::vector<std::type_index>& path,
+// A node is an interface under one key: keyed<T, Key> edges make
+// registrations of the same type under different keys distinct
+using cycle_node = std::pair<std::type_index, std::string>;
+
+template <typename Graph>
+void dfs(const dependency_info& node,
+         const Graph& graph,
+         std::map<cycle_node, visit_state>& states,
+         std::vector<cycle_node>& path,
          std::source_location loc) {
 
-    // For cycle detection we key on type only (regardless of slot variant)
-    auto& state = states[node];
+    // For cycle detection we key on (type, key) only (regardless of slot variant)
+    cycle_node id{node.type, node.key};
+    auto& state = states[id];
     if (state == visit_state::done) return;
     if (state == visit_state::in_progress) {
         // Build cycle path from where the node first appears
-        auto it = std::find(path.begin(), path.end(), node);
-        std::vector<std::type_index> cycle(it, path.end());
-        cycle.push_back(node);
+        auto it = std::find(path.begin(), path.end(), id);
+        std::vector<std::type_index> cycle;
+        for (; it != path.end(); ++it) cycle.push_back(it->first);
+        cycle.push_back(node.type);
         auto ex = cyclic_dependency(cycle, loc);
         // Attach registration stacktraces for all types in the cycle
         std::string detail;
         for (auto& ti : cycle) {
             // Find a descriptor for this type to get its stacktrace
-            for (auto& d : descriptors) {
+            for (std::size_t idx = 0; idx < graph.size(); ++idx) {
+                const auto& d = graph.at(idx);
                 if (d.component_type == ti) {
                     std::string trace = internal::format_registration_trace(d);
                     if (!trace.empty()) {
@@ -145,19 +251,14 @@ void dfs(std::type_index node, bool is_collection, bool is_transient,
     }
 
     state = visit_state::in_progress;
-    path.push_back(node);
-
-    // Find all descriptors that provide this type
-    auto needed_lt = is_transient ? lifetime_kind::transient
-                                  : lifetime_kind::singleton;
-    slot_key sk{node, "", needed_lt, is_collection};
-    auto it = slot_idx.find(sk);
-    if (it != slot_idx.end()) {
-        for (auto idx : it->second) {
-            auto& dep_desc = descriptors[idx];
+    path.push_back(id);
+
+    // Find all descriptors that provide this node
+    if (const auto* slot = graph.dependency_slot(node)) {
+        for (auto idx : *slot) {
+            auto& dep_desc = graph.at(idx);
             for (auto& dep : dep_desc.dependencies) {
-                dfs(dep.type, dep.is_collection, dep.is_transient,
-                    slot_idx, descriptors, states, path, loc);
+                dfs(dep, graph, states, path, loc);
             }
         }
     }
@@ -166,21 +267,43 @@ void dfs(std::type_index node, bool is_collection, bool is_transient,
     state = visit_state::done;
 }
 
-void check_cycles(const std::vector<descriptor>& descriptors,
-                  const std::map<slot_key, std::vector<std::size_t>>& slot_idx,
+// `roots` are the descriptors to start from; `graph` resolves their
+// dependencies.
+template <typename Graph>
+void check_cycles(const descriptor_table& roots,
+                  const Graph& graph,
                   std::source_location loc) {
-    std::map<std::type_index, visit_state> states;
-    std::vector<std::type_index> path;
-
-    for (auto& desc : descriptors) {
-        if (states[desc.component_type] == visit_state::unvisited) {
-            dfs(desc.component_type, desc.is_collection,
-                desc.lifetime == lifetime_kind::transient,
-                slot_idx, descriptors, states, path, loc);
+    std::map<cycle_node, visit_state> states;
+    std::vector<cycle_node> path;
+
+    for (const auto* desc : roots) {
+        dependency_info root{desc->component_type, desc->is_collection,
+                             desc->lifetime == lifetime_kind::transient};
+        root.key = desc->key;
+        if (states[{root.type, root.key}] == visit_state::unvisited) {
+            dfs(root, graph, states, path, loc);
         }
     }
 }
 
+template <typename Graph>
+void validate_table(const descriptor_table& checked,
+                    const Graph& graph,
+                    const build_options& options,
+                    std::source_location loc) {
+    check_missing_dependencies(checked, graph, options, loc);
+    check_exact_deps(checked, graph, loc);
+
+    if (options.validate_lifetimes) {
+        check_lifetime_rules(checked, loc);
+        check_refreshable_deps(checked, graph, loc);
+    }
+
+    if (options.detect_cycles) {
+        check_cycles(checked, graph, loc);
+    }
+}
+
 } // anonymous namespace
 
 // ------------------------------------------------------------------
@@ -189,16 +312,53 @@ void check_cycles(const std::vector<descriptor>& descriptors,
 void validate_descriptors(const std::vector<descriptor>& descriptors,
                           const build_options& options,
                           std::source_location loc) {
-    auto slot_idx = build_slot_index(descriptors);
+    flat_graph graph(descriptors);
+    validate_table(graph.table, graph, options, loc);
+}
 
-    check_missing_dependencies(descriptors, slot_idx, options, loc);
+// ------------------------------------------------------------------
+// Child resolvers: check only the overriding descriptors, resolving
+// their dependencies (and cycles through them) against the merged graph
+// ------------------------------------------------------------------
+void validate_overlay(const internal::resolver_graph& graph,
+                      std::source_location loc) {
+    descriptor_table overrides;
+    overrides.reserve(graph.descriptors.size());
+    for (const auto& d : graph.descriptors) overrides.push_back(&d);
+    validate_table(overrides, graph, graph.options, loc);
 
-    if (options.validate_lifetimes) {
-        check_lifetime_rules(descriptors, loc);
+    // An override can also break an exact<I, TImpl> dependency declared by
+    // a parent registration: recheck those whose dependencies it rebinds
+    descriptor_table rebound;
+    for (const auto& [idx, bound] : graph.rebound) {
+        if (!graph.shadowed.contains(idx)) rebound.push_back(&graph.at(idx));
     }
+    check_exact_deps(rebound, graph, loc);
+}
 
-    if (options.detect_cycles) {
-        check_cycles(descriptors, slot_idx, loc);
+// ------------------------------------------------------------------
+// Startup phases: names must be declared, each once.  Checked even when
+// validate_on_build is off, since a typo would silently drop the phase.
+// ------------------------------------------------------------------
+void check_startup_phases(const std::vector<descriptor>& descriptors,
+                          const build_options& options,
+                          std::source_location loc) {
+    const auto& phases = options.startup_phases;
+    for (auto it = phases.begin(); it != phases.end(); ++it) {
+        if (it->empty() || std::find(phases.begin(), it, *it) != it) {
+            throw di_error("startup phase \"" + *it + "\" is empty or declared twice "
+                           "in build_options::startup_phases", loc);
+        }
+    }
+    for (const auto& d : descriptors) {
+        if (d.startup_phase.empty()) continue;
+        if (std::find(phases.begin(), phases.end(), d.startup_phase) == phases.end()) {
+            auto ex = di_error("Unknown startup phase \"" + d.startup_phase + "\" for "
+                               + internal::demangle(d.component_type)
+                               + "; declare it in build_options::startup_phases", loc);
+            ex.set_diagnostic_detail(internal::format_registration_trace(d));
+            throw ex;
+        }
     }
 }
 
@@ -0,0 +1,175 @@
+#include "watchdog.hpp"
+#include "stacktrace_utils.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace librtdi::internal {
+
+namespace {
+
+std::chrono::milliseconds since(watchdog::clock::time_point start,
+                                watchdog::clock::time_point now) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(now - start);
+}
+
+} // namespace
+
+watchdog::watchdog(construction_deadline defaults, slow_factory_handler report,
+                   hard_timeout_fn on_hard)
+    : defaults_(defaults)
+    , report_(std::move(report))
+    , on_hard_(std::move(on_hard))
+    , thread_([this] { run(); })
+{}
+
+watchdog::~watchdog() {
+    pause();
+}
+
+construction_deadline watchdog::deadline_for(const descriptor& desc) const noexcept {
+    return {
+        desc.deadline.soft.count() != 0 ? desc.deadline.soft : defaults_.soft,
+        desc.deadline.hard.count() != 0 ? desc.deadline.hard : defaults_.hard,
+    };
+}
+
+std::uint64_t watchdog::begin(const std::vector<const descriptor*>& chain,
+                              std::stop_source stop, bool startup) {
+    auto deadline = deadline_for(*chain.back());
+    if (deadline == construction_deadline{}) return 0;
+
+    std::lock_guard lock(mutex_);
+    auto id = ++next_id_;
+    entries_.push_back(entry{id, chain, clock::now(), deadline, std::move(stop), startup});
+    wake_.notify_one();
+    return id;
+}
+
+void watchdog::end(std::uint64_t id) noexcept {
+    if (id == 0) return;
+    std::lock_guard lock(mutex_);
+    std::erase_if(entries_, [id](const entry& e) { return e.id == id; });
+}
+
+void watchdog::pause() {
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    if (thread_.joinable()) thread_.join();
+}
+
+void watchdog::lock_for_fork() {
+    mutex_.lock();
+}
+
+void watchdog::resume(bool in_child) {
+    if (in_child) {
+        // Whoever waited on these is gone; the old ones are abandoned
+        std::construct_at(&mutex_);
+        std::construct_at(&wake_);
+        entries_.clear();
+    } else {
+        mutex_.unlock();
+    }
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = false;
+    }
+    thread_ = std::thread([this] { run(); });
+}
+
+slow_factory_report watchdog::make_report(const entry& e, clock::time_point now, bool hard) {
+    const auto& desc = *e.chain.back();
+    slow_factory_report r{desc.component_type, desc.impl_type, desc.registration_location,
+                          {}, since(e.start, now), hard ? e.deadline.hard : e.deadline.soft,
+                          hard, {}, format_registration_trace(desc)};
+    for (const auto* d : e.chain) r.resolution_chain.push_back(d->component_type);
+
+    r.message = "Factory for " + demangle(desc.component_type);
+    if (desc.impl_type) r.message += " [impl: " + demangle(*desc.impl_type) + "]";
+    if (desc.registration_location.file_name()[0]) {
+        r.message += " (registered at " + std::string(desc.registration_location.file_name())
+                     + ":" + std::to_string(desc.registration_location.line()) + ")";
+    }
+    r.message += " has been running for " + std::to_string(r.elapsed.count())
+                 + " ms, past its " + (hard ? "hard" : "soft") + " deadline of "
+                 + std::to_string(r.deadline.count()) + " ms";
+    if (hard) r.message += "; cancellation requested";
+    if (e.chain.size() > 1) {
+        // Innermost first, as in di_error resolution context
+        std::string ctx;
+        for (auto i = e.chain.size() - 1; i-- > 0;) {
+            if (!ctx.empty()) ctx += " -> ";
+            ctx += demangle(e.chain[i]->component_type);
+        }
+        r.message += " (while resolving " + ctx + ")";
+    }
+    return r;
+}
+
+void watchdog::run() {
+    std::unique_lock lock(mutex_);
+    while (!stopping_) {
+        const auto now = clock::now();
+        auto next = clock::time_point::max();
+        struct due_report {
+            slow_factory_report report;
+            bool startup;
+            std::stop_source stop;   // requested after the report (hard timeouts)
+        };
+        std::vector<due_report> due;
+
+        for (auto& e : entries_) {
+            if (e.deadline.hard.count() != 0 && !e.hard_reported) {
+                if (now >= e.start + e.deadline.hard) {
+                    e.hard_reported = e.soft_reported = true;
+                    due.push_back({make_report(e, now, true), e.startup, e.stop});
+                } else {
+                    next = std::min(next, e.start + e.deadline.hard);
+                }
+            }
+            if (e.deadline.soft.count() != 0 && !e.soft_reported) {
+                if (now >= e.start + e.deadline.soft) {
+                    e.soft_reported = true;
+                    due.push_back({make_report(e, now, false), e.startup,
+                                   std::stop_source{std::nostopstate}});
+                } else {
+                    next = std::min(next, e.start + e.deadline.soft);
+                }
+            }
+        }
+
+        if (!due.empty()) {
+            // Handlers may block or resolve; never call them under the lock
+            lock.unlock();
+            for (auto& [report, startup, stop] : due) {
+                try {
+                    if (report_) report_(report);
+                } catch (...) {
+                    // A failing reporter must not take the watchdog down
+                }
+                if (report.hard_timeout) {
+                    // Fail startup before cancelling, so a factory that
+                    // gives up at once cannot settle it with its own error
+                    if (on_hard_) on_hard_(report, startup);
+                    stop.request_stop();
+                }
+            }
+            lock.lock();
+            continue;
+        }
+
+        if (next == clock::time_point::max()) {
+            wake_.wait(lock);
+        } else {
+            wake_.wait_until(lock, next);
+        }
+    }
+}
+
+} // namespace librtdi::internal
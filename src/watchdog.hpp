@@ -0,0 +1,81 @@
+#pragma once
+
+// Internal construction watchdog: one thread per resolver that reports
+// factory calls running past their construction_deadline.
+// This header is NOT installed — it is only used by the library's .cpp files.
+
+#include "librtdi/descriptor.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace librtdi::internal {
+
+class watchdog {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /// Called on the watchdog thread after a hard timeout was reported,
+    /// before cancellation is requested; `startup` tells whether the
+    /// factory belongs to the resolver's startup.
+    using hard_timeout_fn = std::function<void(const slow_factory_report&, bool startup)>;
+
+    watchdog(construction_deadline defaults, slow_factory_handler report,
+             hard_timeout_fn on_hard);
+    ~watchdog();
+
+    watchdog(const watchdog&) = delete;
+    watchdog& operator=(const watchdog&) = delete;
+
+    /// Effective thresholds of `desc`: its own, else the defaults.
+    construction_deadline deadline_for(const descriptor& desc) const noexcept;
+
+    /// Start watching the factory of `chain.back()`; returns 0 (nothing to
+    /// end) when it has no deadline.  `stop` is requested on a hard timeout.
+    std::uint64_t begin(const std::vector<const descriptor*>& chain,
+                        std::stop_source stop, bool startup);
+    void end(std::uint64_t id) noexcept;
+
+    /// fork() support: pause() stops the thread, then lock_for_fork() holds
+    /// the watchdog's lock across fork(), so that no other thread is inside
+    /// begin() or end() when the process is copied.  resume() releases the
+    /// lock (re-creates it in the child) and restarts the thread.  In the
+    /// child, calls in flight on other (now gone) threads are dropped.
+    void pause();
+    void lock_for_fork();
+    void resume(bool in_child);
+
+private:
+    struct entry {
+        std::uint64_t id;
+        std::vector<const descriptor*> chain;
+        clock::time_point start;
+        construction_deadline deadline;
+        std::stop_source stop;
+        bool startup;
+        bool soft_reported = false;
+        bool hard_reported = false;
+    };
+
+    void run();
+    static slow_factory_report make_report(const entry& e, clock::time_point now, bool hard);
+
+    construction_deadline defaults_;
+    slow_factory_handler report_;
+    hard_timeout_fn on_hard_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::vector<entry> entries_;
+    std::uint64_t next_id_ = 0;
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+} // namespace librtdi::internal
@@ -0,0 +1,25 @@
+// Test plugin module: loaded at runtime by test_plugin.cpp via
+// registry::add_plugin().  Built as a CMake MODULE library.
+
+#include "codec_plugin_api.hpp"
+
+#include <librtdi.hpp>
+
+#include <string>
+
+namespace {
+
+struct GzipCodec : plugin_test::ICodec {
+    plugin_test::IDictionary& dict_;
+    explicit GzipCodec(plugin_test::IDictionary& d) : dict_(d) {}
+    std::string name() const override { return "gzip:" + dict_.word(); }
+};
+
+} // namespace
+
+LIBRTDI_PLUGIN_EXPORT void make_gzip_codec(librtdi::resolver& r, librtdi::erased_ptr& out) {
+    out = librtdi::make_erased_as<plugin_test::ICodec, GzipCodec>(
+        r.get<plugin_test::IDictionary>());
+}
+
+LIBRTDI_PLUGIN_EXPORT void make_nothing(librtdi::resolver&, librtdi::erased_ptr&) {}
@@ -0,0 +1,19 @@
+#pragma once
+
+// Interfaces shared between test_plugin.cpp and the codec_plugin module.
+
+#include <string>
+
+namespace plugin_test {
+
+struct IDictionary {
+    virtual ~IDictionary() = default;
+    virtual std::string word() const = 0;
+};
+
+struct ICodec {
+    virtual ~ICodec() = default;
+    virtual std::string name() const = 0;
+};
+
+} // namespace plugin_test
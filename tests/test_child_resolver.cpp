@@ -0,0 +1,260 @@
+#include <catch2/catch_test_macros.hpp>
+#include <librtdi.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct IClock {
+    virtual ~IClock() = default;
+    virtual int now() const = 0;
+};
+
+struct SystemClock : IClock {
+    int now() const override { return 1; }
+};
+
+struct FakeClock : IClock {
+    int now() const override { return 42; }
+};
+
+struct ILogger {
+    virtual ~ILogger() = default;
+};
+
+static int g_loggers = 0;
+
+struct Logger : ILogger {
+    Logger() { ++g_loggers; }
+};
+
+struct IScheduler {
+    virtual ~IScheduler() = default;
+    virtual IClock& clock() const = 0;
+};
+
+struct Scheduler : IScheduler {
+    IClock& clock_;
+    explicit Scheduler(IClock& c) : clock_(c) {}
+    IClock& clock() const override { return clock_; }
+};
+
+struct IMissing {
+    virtual ~IMissing() = default;
+};
+
+struct NeedsMissing : IClock {
+    explicit NeedsMissing(IMissing&) {}
+    int now() const override { return 0; }
+};
+
+struct IBase {
+    virtual ~IBase() = default;
+    virtual std::string name() const = 0;
+};
+
+struct IDerived : IBase {};
+
+struct DerivedA : IDerived {
+    std::string name() const override { return "A"; }
+};
+
+struct DerivedB : IDerived {
+    std::string name() const override { return "B"; }
+};
+
+struct IPlugin {
+    virtual ~IPlugin() = default;
+};
+
+struct Plugin : IPlugin {};
+
+struct IHost {
+    virtual ~IHost() = default;
+    virtual std::size_t plugins() const = 0;
+};
+
+struct Host : IHost {
+    std::size_t count_;
+    explicit Host(std::vector<IPlugin*> ps) : count_(ps.size()) {}
+    std::size_t plugins() const override { return count_; }
+};
+
+struct ITicker {
+    virtual ~ITicker() = default;
+    virtual int tick() const = 0;
+};
+
+struct Ticker : ITicker {
+    IClock& clock_;
+    explicit Ticker(IClock& c) : clock_(c) {}
+    int tick() const override { return clock_.now(); }
+};
+
+struct IMonitor {
+    virtual ~IMonitor() = default;
+    virtual int reading() const = 0;
+};
+
+struct Monitor : IMonitor {
+    int reading_ = 0;
+    explicit Monitor(std::vector<std::unique_ptr<ITicker>> ts) {
+        for (const auto& t : ts) reading_ += t->tick();
+    }
+    int reading() const override { return reading_; }
+};
+
+} // namespace
+
+TEST_CASE("child resolver overrides a slot and falls through for the rest", "[child]") {
+    librtdi::registry reg;
+    reg.add_singleton<IClock, SystemClock>();
+    reg.add_singleton<ILogger, Logger>();
+    auto parent = reg.build({.eager_singletons = false});
+
+    librtdi::registry overrides;
+    overrides.add_singleton<IClock, FakeClock>();
+    auto child = parent->create_child(std::move(overrides), {.eager_singletons = false});
+
+    REQUIRE(child->get<IClock>().now() == 42);
+    REQUIRE(parent->get<IClock>().now() == 1);
+    REQUIRE(&child->get<ILogger>() == &parent->get<ILogger>());
+}
+
+TEST_CASE("child resolver shares unaffected singletons and rebuilds dependents", "[child]") {
+    g_loggers = 0;
+    librtdi::registry reg;
+    reg.add_singleton<IClock, SystemClock>();
+    reg.add_singleton<ILogger, Logger>();
+    reg.add_singleton<IScheduler, Scheduler>(librtdi::deps<IClock>);
+    auto parent = reg.build();
+    REQUIRE(g_loggers == 1);
+
+    librtdi::registry overrides;
+    overrides.add_singleton<IClock, FakeClock>();
+    auto child = parent->create_child(std::move(overrides));
+
+    // Logger does not depend on IClock: the parent's instance is reused
+    REQUIRE(g_loggers == 1);
+    REQUIRE(&child->get<ILogger>() == &parent->get<ILogger>());
+
+    // Scheduler depends on the overridden slot: re-created in the child
+    auto& child_sched = child->get<IScheduler>();
+    REQUIRE(&child_sched != &parent->get<IScheduler>());
+    REQUIRE(child_sched.clock().now() == 42);
+    REQUIRE(parent->get<IScheduler>().clock().now() == 1);
+}
+
+TEST_CASE("child resolver redirects parent forwards to the override", "[child]") {
+    librtdi::registry reg;
+    reg.add_singleton<IDerived, DerivedA>();
+    reg.forward<IBase, IDerived>();
+    auto parent = reg.build();
+
+    librtdi::registry overrides;
+    overrides.add_singleton<IDerived, DerivedB>();
+    auto child = parent->create_child(std::move(overrides));
+
+    REQUIRE(parent->get<IBase>().name() == "A");
+    REQUIRE(child->get<IBase>().name() == "B");
+    REQUIRE(&child->get<IBase>() == static_cast<IBase*>(&child->get<IDerived>()));
+}
+
+TEST_CASE("child resolver validates only the overrides", "[child]") {
+    librtdi::registry reg;
+    reg.add_singleton<IClock, SystemClock>();
+    auto parent = reg.build();
+
+    librtdi::registry overrides;
+    overrides.add_singleton<IClock, NeedsMissing>(librtdi::deps<IMissing>);
+    REQUIRE_THROWS_AS(parent->create_child(std::move(overrides)), librtdi::not_found);
+
+    // Overrides may depend on parent registrations
+    librtdi::registry ok;
+    ok.add_singleton<IScheduler, Scheduler>(librtdi::deps<IClock>);
+    auto child = parent->create_child(std::move(ok));
+    REQUIRE(&child->get<IScheduler>().clock() == &parent->get<IClock>());
+}
+
+TEST_CASE("grandchild resolver falls through every level", "[child]") {
+    g_loggers = 0;
+    librtdi::registry reg;
+    reg.add_singleton<IClock, SystemClock>();
+    reg.add_singleton<ILogger, Logger>();
+    auto root = reg.build();
+
+    librtdi::registry mid_overrides;
+    mid_overrides.add_singleton<IScheduler, Scheduler>(librtdi::deps<IClock>);
+    auto mid = root->create_child(std::move(mid_overrides));
+
+    librtdi::registry leaf_overrides;
+    leaf_overrides.add_singleton<IClock, FakeClock>();
+    auto leaf = mid->create_child(std::move(leaf_overrides));
+
+    REQUIRE(g_loggers == 1);
+    REQUIRE(&leaf->get<ILogger>() == &root->get<ILogger>());
+    REQUIRE(mid->get<IScheduler>().clock().now() == 1);
+    REQUIRE(leaf->get<IScheduler>().clock().now() == 42);
+}
+
+TEST_CASE("child resolver keeps its parent alive", "[child]") {
+    librtdi::registry reg;
+    reg.add_singleton<ILogger, Logger>();
+    auto parent = reg.build();
+    auto* logger = &parent->get<ILogger>();
+
+    auto child = parent->create_child(librtdi::registry{});
+    parent.reset();
+    REQUIRE(&child->get<ILogger>() == logger);
+}
+
+TEST_CASE("child resolver rebinds parent singletons to slots it adds", "[child]") {
+    librtdi::registry reg;
+    reg.add_singleton<IHost, Host>(librtdi::deps<librtdi::collection<IPlugin>>);
+    auto parent = reg.build();
+
+    librtdi::registry overrides;
+    overrides.add_collection<IPlugin, Plugin>(librtdi::lifetime_kind::singleton);
+    auto child = parent->create_child(std::move(overrides));
+
+    REQUIRE(parent->get<IHost>().plugins() == 0);
+    REQUIRE(child->get<IHost>().plugins() == 1);
+}
+
+TEST_CASE("child resolver re-creates singletons that reach an override through transients",
+          "[child]") {
+    librtdi::registry reg;
+    reg.add_singleton<IClock, SystemClock>();
+    reg.add_collection<ITicker, Ticker>(librtdi::lifetime_kind::transient,
+                                        librtdi::deps<IClock>);
+    reg.add_singleton<IMonitor, Monitor>(
+        librtdi::deps<librtdi::collection<librtdi::transient<ITicker>>>);
+    auto parent = reg.build();
+
+    librtdi::registry overrides;
+    overrides.add_singleton<IClock, FakeClock>();
+    auto child = parent->create_child(std::move(overrides));
+
+    REQUIRE(parent->get<IMonitor>().reading() == 1);
+    REQUIRE(child->get<IMonitor>().reading() == 42);
+}
+
+TEST_CASE("child resolver eagerly creates only the singletons it owns", "[child]") {
+    g_loggers = 0;
+    librtdi::registry reg;
+    reg.add_singleton<IClock, SystemClock>();
+    reg.add_singleton<ILogger, Logger>();
+    reg.add_singleton<IScheduler, Scheduler>(librtdi::deps<IClock>);
+    auto parent = reg.build({.eager_singletons = false});
+
+    librtdi::registry overrides;
+    overrides.add_singleton<IClock, FakeClock>();
+    auto child = parent->create_child(std::move(overrides));
+
+    // Shared singletons stay with the parent's startup (lazy here)
+    REQUIRE(g_loggers == 0);
+    REQUIRE(&child->get<ILogger>() == &parent->get<ILogger>());
+    REQUIRE(g_loggers == 1);
+    REQUIRE(child->get<IScheduler>().clock().now() == 42);
+}
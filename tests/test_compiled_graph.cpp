@@ -0,0 +1,108 @@
+#include <catch2/catch_test_macros.hpp>
+#include <librtdi.hpp>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+static int g_tenant_caches = 0;
+
+struct ITenantCache {
+    virtual ~ITenantCache() = default;
+    virtual int id() const = 0;
+};
+
+struct TenantCache : ITenantCache {
+    int id_;
+    TenantCache() : id_(++g_tenant_caches) {}
+    int id() const override { return id_; }
+};
+
+struct IHandler {
+    virtual ~IHandler() = default;
+    virtual ITenantCache& cache() const = 0;
+};
+
+struct Handler : IHandler {
+    ITenantCache& cache_;
+    explicit Handler(ITenantCache& c) : cache_(c) {}
+    ITenantCache& cache() const override { return cache_; }
+};
+
+struct IMissing {
+    virtual ~IMissing() = default;
+};
+
+struct NeedsMissing : IHandler {
+    explicit NeedsMissing(IMissing&) {}
+    ITenantCache& cache() const override { throw std::logic_error("unused"); }
+};
+
+} // namespace
+
+TEST_CASE("compiled_graph instantiates independent resolvers", "[compiled_graph]") {
+    g_tenant_caches = 0;
+    librtdi::registry reg;
+    reg.add_singleton<ITenantCache, TenantCache>();
+    reg.add_singleton<IHandler, Handler>(librtdi::deps<ITenantCache>);
+
+    auto graph = reg.compile({.eager_singletons = false});
+    REQUIRE(g_tenant_caches == 0);
+
+    auto a = graph->instantiate();
+    auto b = graph->instantiate();
+    REQUIRE(a != b);
+
+    auto& ha = a->get<IHandler>();
+    auto& hb = b->get<IHandler>();
+    REQUIRE(&ha != &hb);
+    REQUIRE(&ha.cache() == &a->get<ITenantCache>());
+    REQUIRE(&hb.cache() == &b->get<ITenantCache>());
+    REQUIRE(g_tenant_caches == 2);
+}
+
+TEST_CASE("compiled_graph honors eager_singletons per instantiate", "[compiled_graph]") {
+    g_tenant_caches = 0;
+    librtdi::registry reg;
+    reg.add_singleton<ITenantCache, TenantCache>();
+
+    auto graph = reg.compile();
+    REQUIRE(g_tenant_caches == 0);
+
+    auto a = graph->instantiate();
+    REQUIRE(g_tenant_caches == 1);
+    auto b = graph->instantiate();
+    REQUIRE(g_tenant_caches == 2);
+    REQUIRE(a->get<ITenantCache>().id() != b->get<ITenantCache>().id());
+}
+
+TEST_CASE("compiled_graph shares descriptor tables", "[compiled_graph]") {
+    librtdi::registry reg;
+    reg.add_singleton<ITenantCache, TenantCache>();
+    reg.add_singleton<IHandler, Handler>(librtdi::deps<ITenantCache>);
+
+    auto graph = reg.compile({.eager_singletons = false});
+    REQUIRE(graph->descriptors().size() == 2);
+    REQUIRE_FALSE(graph->options().eager_singletons);
+
+    // Resolvers keep the graph alive on their own
+    auto r = graph->instantiate();
+    graph.reset();
+    REQUIRE(&r->get<IHandler>().cache() == &r->get<ITenantCache>());
+}
+
+TEST_CASE("compile validates once, before any instantiate", "[compiled_graph]") {
+    librtdi::registry reg;
+    reg.add_singleton<IHandler, NeedsMissing>(librtdi::deps<IMissing>);
+    REQUIRE_THROWS_AS(reg.compile(), librtdi::not_found);
+}
+
+TEST_CASE("compile consumes the registry", "[compiled_graph]") {
+    librtdi::registry reg;
+    reg.add_singleton<ITenantCache, TenantCache>();
+    auto graph = reg.compile();
+    REQUIRE_THROWS_AS(reg.compile(), librtdi::di_error);
+    REQUIRE_THROWS_AS(reg.build(), librtdi::di_error);
+    REQUIRE_THROWS_AS((reg.add_singleton<IHandler, Handler>(librtdi::deps<ITenantCache>)),
+                      librtdi::di_error);
+}
@@ -599,6 +599,81 @@ TEST_CASE("resolution chain context: three-level nesting shows full chain", "[di
     }
 }
 
+TEST_CASE("resolution chain context: chain lists every level once, innermost first", "[diagnostics][resolution-chain]") {
+    struct IL0 { virtual ~IL0() = default; };
+    struct IL1 { virtual ~IL1() = default; };
+    struct IL2 { virtual ~IL2() = default; };
+    struct IL3 { virtual ~IL3() = default; };
+    struct L0Impl : IL0 { L0Impl() { throw std::runtime_error("deep boom"); } };
+    struct L1Impl : IL1 { explicit L1Impl(IL0&) {} };
+    struct L2Impl : IL2 { explicit L2Impl(IL1&) {} };
+    struct L3Impl : IL3 { explicit L3Impl(IL2&) {} };
+
+    librtdi::registry reg;
+    reg.add_singleton<IL0, L0Impl>();
+    reg.add_singleton<IL1, L1Impl>(librtdi::deps<IL0>);
+    reg.add_singleton<IL2, L2Impl>(librtdi::deps<IL1>);
+    reg.add_singleton<IL3, L3Impl>(librtdi::deps<IL2>);
+    auto r = reg.build({.validate_on_build = false, .eager_singletons = false});
+
+    try {
+        r->get<IL3>();
+        FAIL("Expected resolution_error");
+    } catch (const librtdi::resolution_error& e) {
+        std::string msg = e.what();
+        REQUIRE_THAT(msg, Catch::Matchers::ContainsSubstring("IL0"));
+        auto ctx = msg.substr(msg.find("(while resolving "));
+        auto l1 = ctx.find("IL1");
+        auto l2 = ctx.find("IL2");
+        auto l3 = ctx.find("IL3");
+        REQUIRE(l1 != std::string::npos);
+        REQUIRE(l1 < l2);
+        REQUIRE(l2 < l3);
+        REQUIRE(ctx.find("IL0") == std::string::npos);
+        REQUIRE(ctx.find("while resolving", 2) == std::string::npos);
+        REQUIRE(e.component_type() == typeid(IL0));
+    }
+
+    // The failed singleton is not cached; the next attempt fails the same way
+    REQUIRE_THROWS_AS(r->get<IL3>(), librtdi::resolution_error);
+}
+
+TEST_CASE("resolution chain context: a swallowed inner failure is not blamed", "[diagnostics][resolution-chain]") {
+    struct IR { virtual ~IR() = default; };
+    struct IOuter { virtual ~IOuter() = default; };
+    struct IMid { virtual ~IMid() = default; };
+    struct RImpl : IR { RImpl() { throw std::runtime_error("inner failed"); } };
+    struct OuterImpl : IOuter {
+        explicit OuterImpl(librtdi::refreshable_ref<IR> ref) {
+            try {
+                static_cast<void>(ref.acquire());
+            } catch (const std::exception&) {
+                // Swallowed; this factory then fails on its own
+            }
+            throw std::runtime_error("outer failed");
+        }
+    };
+    struct MidImpl : IMid { explicit MidImpl(IOuter&) {} };
+
+    librtdi::registry reg;
+    reg.add_refreshable<IR, RImpl>();
+    reg.add_singleton<IOuter, OuterImpl>(librtdi::deps<librtdi::refreshable<IR>>);
+    reg.add_singleton<IMid, MidImpl>(librtdi::deps<IOuter>);
+    auto r = reg.build({.validate_on_build = false, .eager_singletons = false});
+
+    try {
+        r->get<IMid>();
+        FAIL("Expected resolution_error");
+    } catch (const librtdi::resolution_error& e) {
+        std::string msg = e.what();
+        REQUIRE(e.component_type() == typeid(IOuter));
+        REQUIRE_THAT(msg, Catch::Matchers::ContainsSubstring("outer failed"));
+        auto ctx = msg.substr(msg.find("(while resolving "));
+        REQUIRE_THAT(ctx, Catch::Matchers::ContainsSubstring("IMid"));
+        REQUIRE(ctx.find("IR") == std::string::npos);
+    }
+}
+
 TEST_CASE("resolution chain context: transient create path", "[diagnostics][resolution-chain]") {
     struct IMissingT { virtual ~IMissingT() = default; };
     struct ITransientTop { virtual ~ITransientTop() = default; };
@@ -3,6 +3,8 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <typeindex>
+#include <typeinfo>
 #include <vector>
 
 namespace {
@@ -294,3 +296,95 @@ TEST_CASE("lazy singleton teardown destroys only created singletons",
     REQUIRE(resolved_destructions == 1);
     REQUIRE(unresolved_destructions == 0);
 }
+
+// ---------------------------------------------------------------
+// collect_eager_errors: report every failure at once
+// ---------------------------------------------------------------
+
+TEST_CASE("collect_eager_errors reports every failing singleton",
+          "[eager][collect]") {
+    static std::vector<std::string> events;
+    events.clear();
+
+    struct IOther { virtual ~IOther() = default; };
+    struct OtherBroken : IOther {
+        OtherBroken() { throw std::runtime_error("other failed"); }
+    };
+    struct IDependent { virtual ~IDependent() = default; };
+    struct Dependent : IDependent {
+        explicit Dependent(IBroken&) { events.push_back("dependent built"); }
+    };
+    struct IHealthy { virtual ~IHealthy() = default; };
+    struct Healthy final : IHealthy {
+        ~Healthy() override { events.push_back("healthy destroyed"); }
+    };
+    struct IUser { virtual ~IUser() = default; };
+    struct User final : IUser {
+        explicit User(IHealthy&) {}
+        ~User() override { events.push_back("user destroyed"); }
+    };
+
+    librtdi::registry reg;
+    reg.add_singleton<IDependent, Dependent>(librtdi::deps<IBroken>);
+    reg.add_singleton<IBroken, Broken>();
+    reg.add_singleton<IUser, User>(librtdi::deps<IHealthy>);
+    reg.add_singleton<IHealthy, Healthy>();
+    reg.add_singleton<IOther, OtherBroken>();
+
+    try {
+        reg.build({.collect_eager_errors = true});
+        FAIL("Expected eager_construction_error");
+    } catch (const librtdi::eager_construction_error& e) {
+        const auto& failures = e.failures();
+        REQUIRE(failures.size() == 2);
+        REQUIRE(failures[0].component_type == typeid(IBroken));
+        REQUIRE(failures[0].message.find("factory failed") != std::string::npos);
+        REQUIRE(failures[1].component_type == typeid(IOther));
+        REQUIRE_THROWS_AS(std::rethrow_exception(failures[1].error),
+                          librtdi::resolution_error);
+        REQUIRE(e.skipped() == std::vector<std::type_index>{typeid(IDependent)});
+
+        std::string msg = e.what();
+        REQUIRE(msg.find("factory failed") != std::string::npos);
+        REQUIRE(msg.find("other failed") != std::string::npos);
+    }
+
+    // The healthy part was built and torn down consumer-first
+    REQUIRE(events == std::vector<std::string>{"user destroyed", "healthy destroyed"});
+}
+
+TEST_CASE("collect_eager_errors keeps the resolution chain of nested failures",
+          "[eager][collect]") {
+    struct IWorker { virtual ~IWorker() = default; };
+    struct Worker : IWorker {
+        explicit Worker(std::unique_ptr<IBroken>) {}
+    };
+
+    librtdi::registry reg;
+    reg.add_transient<IBroken, Broken>();
+    reg.add_singleton<IWorker, Worker>(librtdi::deps<librtdi::transient<IBroken>>);
+    reg.add_singleton<IService, Service>();
+
+    try {
+        // Transient failures are only seen through their singleton consumer
+        reg.build({.validate_lifetimes = false, .collect_eager_errors = true});
+        FAIL("Expected eager_construction_error");
+    } catch (const librtdi::eager_construction_error& e) {
+        REQUIRE(e.failures().size() == 1);
+        const auto& f = e.failures()[0];
+        REQUIRE(f.component_type == typeid(IWorker));
+        REQUIRE(f.message.find("factory failed") != std::string::npos);
+        REQUIRE(f.message.find("while resolving") != std::string::npos);
+        REQUIRE(e.skipped().empty());
+    }
+}
+
+TEST_CASE("collect_eager_errors succeeds like plain eager creation",
+          "[eager][collect]") {
+    g_factory_calls = 0;
+    librtdi::registry reg;
+    reg.add_singleton<ICounter, Counter>();
+    reg.add_singleton<IService, Service>();
+    auto r = reg.build({.collect_eager_errors = true});
+    REQUIRE(g_factory_calls == 2);
+}
@@ -0,0 +1,207 @@
+#include <catch2/catch_test_macros.hpp>
+#include <librtdi.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+static int g_tables_created = 0;
+static int g_tables_destroyed = 0;
+
+struct ITable {
+    virtual ~ITable() = default;
+    virtual int generation() const = 0;
+};
+
+struct Table : ITable {
+    int generation_;
+    Table() : generation_(++g_tables_created) {}
+    ~Table() override { ++g_tables_destroyed; }
+    int generation() const override { return generation_; }
+};
+
+struct ITemplates {
+    virtual ~ITemplates() = default;
+};
+
+struct Templates : ITemplates {};
+
+struct IRenderer {
+    virtual ~IRenderer() = default;
+    virtual int table_generation() const = 0;
+};
+
+struct Renderer : IRenderer {
+    librtdi::refreshable_ref<ITable> table_;
+    explicit Renderer(librtdi::refreshable_ref<ITable> t) : table_(t) {}
+    int table_generation() const override { return table_.acquire()->generation(); }
+};
+
+struct RawRenderer : IRenderer {
+    ITable& table_;
+    explicit RawRenderer(ITable& t) : table_(t) {}
+    int table_generation() const override { return table_.generation(); }
+};
+
+void reset_counters() {
+    g_tables_created = 0;
+    g_tables_destroyed = 0;
+}
+
+} // namespace
+
+TEST_CASE("evictable singletons are created lazily and accounted", "[evictable]") {
+    reset_counters();
+    librtdi::registry reg;
+    reg.add_evictable<ITable, Table>(1000);
+    auto r = reg.build();
+
+    REQUIRE(g_tables_created == 0);
+    REQUIRE(r->evictable_bytes() == 0);
+
+    auto first = r->acquire<ITable>();
+    REQUIRE(first->generation() == 1);
+    REQUIRE(r->acquire<ITable>().get() == first.get());
+    REQUIRE(r->evictable_bytes() == 1000);
+}
+
+TEST_CASE("trim evicts and the next acquire re-creates", "[evictable]") {
+    reset_counters();
+    librtdi::registry reg;
+    reg.add_evictable<ITable, Table>(1000);
+    auto r = reg.build();
+
+    static_cast<void>(r->acquire<ITable>());
+    REQUIRE(r->trim() == 1000);
+    REQUIRE(r->evictable_bytes() == 0);
+    REQUIRE(g_tables_destroyed == 1);
+    REQUIRE(r->trim() == 0);
+
+    REQUIRE(r->acquire<ITable>()->generation() == 2);
+    REQUIRE(r->evictable_bytes() == 1000);
+}
+
+TEST_CASE("pinned instances survive eviction until released", "[evictable]") {
+    reset_counters();
+    librtdi::registry reg;
+    reg.add_evictable<ITable, Table>(1000);
+    auto r = reg.build();
+
+    auto pinned = r->acquire<ITable>();
+    REQUIRE(r->trim() == 1000);
+    REQUIRE(g_tables_destroyed == 0);
+    REQUIRE(pinned->generation() == 1);
+
+    REQUIRE(r->acquire<ITable>()->generation() == 2);
+    pinned = {};
+    REQUIRE(g_tables_destroyed == 1);
+}
+
+TEST_CASE("eviction_budget evicts the least recently used instance", "[evictable]") {
+    reset_counters();
+    librtdi::registry reg;
+    reg.add_evictable<ITable, Table>("a", 400);
+    reg.add_evictable<ITable, Table>("b", 400);
+    reg.add_evictable<ITable, Table>("c", 400);
+    auto r = reg.build({.eviction_budget = 1000});
+
+    auto* a = r->acquire<ITable>("a").get();
+    static_cast<void>(r->acquire<ITable>("b"));
+    static_cast<void>(r->acquire<ITable>("a"));   // b is now least recently used
+    REQUIRE(r->evictable_bytes() == 800);
+
+    static_cast<void>(r->acquire<ITable>("c"));
+    REQUIRE(r->evictable_bytes() == 800);
+    REQUIRE(g_tables_destroyed == 1);
+    REQUIRE(r->acquire<ITable>("a").get() == a);
+
+    // b is re-created on demand, pushing out c (now the oldest)
+    REQUIRE(r->acquire<ITable>("b")->generation() == 4);
+    REQUIRE(r->evictable_bytes() == 800);
+    REQUIRE(g_tables_destroyed == 2);
+}
+
+TEST_CASE("trim to a target keeps the most recently used instances", "[evictable]") {
+    librtdi::registry reg;
+    reg.add_evictable<ITable, Table>(300);
+    reg.add_evictable<ITemplates, Templates>(500);
+    auto r = reg.build();
+
+    static_cast<void>(r->acquire<ITemplates>());
+    static_cast<void>(r->acquire<ITable>());
+    REQUIRE(r->trim(400) == 500);
+    REQUIRE(r->evictable_bytes() == 300);
+}
+
+TEST_CASE("evictable<T> dependencies re-acquire after eviction", "[evictable]") {
+    reset_counters();
+    librtdi::registry reg;
+    reg.add_evictable<ITable, Table>(1000);
+    reg.add_singleton<IRenderer, Renderer>(librtdi::deps<librtdi::evictable<ITable>>);
+    auto r = reg.build();
+
+    auto& renderer = r->get<IRenderer>();
+    REQUIRE(renderer.table_generation() == 1);
+    r->trim();
+    REQUIRE(renderer.table_generation() == 2);
+}
+
+TEST_CASE("evictable misuse is reported", "[evictable]") {
+    SECTION("get<T>() on an evictable slot throws") {
+        librtdi::registry reg;
+        reg.add_evictable<ITable, Table>(1);
+        auto r = reg.build();
+        REQUIRE_THROWS_AS(r->get<ITable>(), librtdi::di_error);
+    }
+
+    SECTION("evictable slots cannot be refreshed") {
+        librtdi::registry reg;
+        reg.add_evictable<ITable, Table>(1);
+        auto r = reg.build();
+        REQUIRE_THROWS_AS(r->refresh<ITable>(), librtdi::di_error);
+    }
+
+    SECTION("plain dependency on an evictable slot fails validation") {
+        librtdi::registry reg;
+        reg.add_evictable<ITable, Table>(1);
+        reg.add_transient<IRenderer, RawRenderer>(librtdi::deps<ITable>);
+        REQUIRE_THROWS_AS(reg.build(), librtdi::lifetime_mismatch);
+    }
+
+    SECTION("duplicate registration in the singleton slot") {
+        librtdi::registry reg;
+        reg.add_singleton<ITable, Table>();
+        REQUIRE_THROWS_AS((reg.add_evictable<ITable, Table>(1)),
+                          librtdi::duplicate_registration);
+    }
+}
+
+TEST_CASE("concurrent acquire and trim", "[evictable]") {
+    librtdi::registry reg;
+    reg.add_evictable<ITable, Table>("a", 1);
+    reg.add_evictable<ITable, Table>("b", 1);
+    auto r = reg.build({.eviction_budget = 1});
+
+    std::atomic<bool> stop{false};
+    std::atomic<bool> valid{true};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&, i] {
+            const char* key = (i % 2) ? "a" : "b";
+            while (!stop.load()) {
+                auto g = r->acquire<ITable>(key);
+                if (!g || g->generation() <= 0) valid = false;
+            }
+        });
+    }
+    for (int i = 0; i < 200; ++i) {
+        r->trim();
+    }
+    stop = true;
+    for (auto& t : readers) t.join();
+
+    REQUIRE(valid);
+    REQUIRE(r->evictable_bytes() <= 1);
+}
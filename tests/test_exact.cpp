@@ -0,0 +1,156 @@
+#include <catch2/catch_test_macros.hpp>
+#include <librtdi.hpp>
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace {
+
+struct ICodec {
+    virtual ~ICodec() = default;
+    virtual int encode(int v) const = 0;
+};
+
+struct FastCodec final : ICodec {
+    int encode(int v) const override { return v + 1; }
+};
+
+struct OtherCodec final : ICodec {
+    int encode(int v) const override { return v - 1; }
+};
+
+struct ILogger {
+    virtual ~ILogger() = default;
+};
+
+// Implements two interfaces; ICodec is not the primary base
+struct CodecLogger final : ILogger, ICodec {
+    int encode(int v) const override { return v * 2; }
+};
+
+struct IPipeline {
+    virtual ~IPipeline() = default;
+    virtual int run(int v) const = 0;
+};
+
+struct Pipeline : IPipeline {
+    FastCodec& codec;
+    explicit Pipeline(FastCodec& c) : codec(c) {}
+    int run(int v) const override { return codec.encode(v); }
+};
+
+struct CodecDecorator : ICodec {
+    librtdi::decorated_ptr<ICodec> inner_;
+    explicit CodecDecorator(librtdi::decorated_ptr<ICodec> inner)
+        : inner_(std::move(inner)) {}
+    int encode(int v) const override { return inner_->encode(v) * 10; }
+};
+
+struct NonFinalCodec : ICodec {
+    int encode(int v) const override { return v; }
+};
+
+} // namespace
+
+static_assert(librtdi::exact_impl_of<FastCodec, ICodec>);
+static_assert(!librtdi::exact_impl_of<NonFinalCodec, ICodec>);
+static_assert(std::is_same_v<librtdi::inject_type_t<librtdi::exact<ICodec, FastCodec>>,
+                             FastCodec&>);
+
+TEST_CASE("get_exact returns the bound implementation", "[exact]") {
+    librtdi::registry reg;
+    reg.add_singleton<ICodec, FastCodec>();
+    reg.add_singleton<ICodec, OtherCodec>("other");
+    auto r = reg.build();
+
+    FastCodec& codec = r->get_exact<ICodec, FastCodec>();
+    REQUIRE(&codec == &r->get<ICodec>());
+    REQUIRE(codec.encode(1) == 2);
+
+    REQUIRE(&r->get_exact<ICodec, OtherCodec>("other") == &r->get<ICodec>("other"));
+}
+
+TEST_CASE("get_exact reports mismatches and missing slots", "[exact]") {
+    librtdi::registry reg;
+    reg.add_singleton<ICodec, FastCodec>();
+    auto r = reg.build();
+
+    try {
+        r->get_exact<ICodec, OtherCodec>();
+        FAIL("expected di_error");
+    } catch (const librtdi::di_error& e) {
+        REQUIRE(std::string(e.what()).find("FastCodec") != std::string::npos);
+    }
+    REQUIRE_THROWS_AS((r->get_exact<ICodec, FastCodec>("missing")), librtdi::not_found);
+    REQUIRE_THROWS_AS((r->get_exact<ILogger, CodecLogger>()), librtdi::not_found);
+}
+
+TEST_CASE("exact<I, TImpl> injects the concrete type", "[exact]") {
+    librtdi::registry reg;
+    reg.add_singleton<ICodec, FastCodec>();
+    reg.add_singleton<IPipeline, Pipeline>(librtdi::deps<librtdi::exact<ICodec, FastCodec>>);
+    auto r = reg.build();
+
+    auto& pipeline = r->get<IPipeline>();
+    REQUIRE(pipeline.run(1) == 2);
+    REQUIRE(&static_cast<Pipeline&>(pipeline).codec == &r->get<ICodec>());
+
+    auto [codec] = r->get_many<librtdi::exact<ICodec, FastCodec>>();
+    REQUIRE(&codec == &r->get_exact<ICodec, FastCodec>());
+}
+
+TEST_CASE("exact works through a non-primary base and a forward", "[exact]") {
+    librtdi::registry reg;
+    reg.add_singleton<CodecLogger, CodecLogger>();
+    reg.forward<ICodec, CodecLogger>();
+    auto r = reg.build();
+
+    CodecLogger& codec = r->get_exact<ICodec, CodecLogger>();
+    REQUIRE(&codec == &r->get<CodecLogger>());
+    REQUIRE(codec.encode(3) == 6);
+}
+
+TEST_CASE("exact dependencies are checked at build time", "[exact]") {
+    SECTION("different implementation") {
+        librtdi::registry reg;
+        reg.add_singleton<ICodec, OtherCodec>();
+        reg.add_singleton<IPipeline, Pipeline>(librtdi::deps<librtdi::exact<ICodec, FastCodec>>);
+        try {
+            reg.build();
+            FAIL("expected di_error");
+        } catch (const librtdi::di_error& e) {
+            std::string msg = e.what();
+            REQUIRE(msg.find("OtherCodec") != std::string::npos);
+            REQUIRE(msg.find("Pipeline") != std::string::npos);
+        }
+    }
+
+    SECTION("decorated slot") {
+        librtdi::registry reg;
+        reg.add_singleton<ICodec, FastCodec>();
+        reg.decorate<ICodec, CodecDecorator>();
+        reg.add_singleton<IPipeline, Pipeline>(librtdi::deps<librtdi::exact<ICodec, FastCodec>>);
+        REQUIRE_THROWS_AS(reg.build(), librtdi::di_error);
+    }
+
+    SECTION("decorated slot rejects get_exact") {
+        librtdi::registry reg;
+        reg.add_singleton<ICodec, FastCodec>();
+        reg.decorate<ICodec, CodecDecorator>();
+        auto r = reg.build();
+        REQUIRE_THROWS_AS((r->get_exact<ICodec, FastCodec>()), librtdi::di_error);
+        REQUIRE(r->get<ICodec>().encode(1) == 20);
+    }
+
+    SECTION("child override breaks a parent's exact dependency") {
+        librtdi::registry reg;
+        reg.add_singleton<ICodec, FastCodec>();
+        reg.add_singleton<IPipeline, Pipeline>(librtdi::deps<librtdi::exact<ICodec, FastCodec>>);
+        auto parent = reg.build();
+
+        librtdi::registry overrides;
+        overrides.add_singleton<ICodec, OtherCodec>();
+        REQUIRE_THROWS_AS(parent->create_child(std::move(overrides)), librtdi::di_error);
+    }
+}
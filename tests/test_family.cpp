@@ -0,0 +1,234 @@
+#include <catch2/catch_test_macros.hpp>
+#include <librtdi.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> g_events;
+
+struct IPool {
+    virtual ~IPool() = default;
+};
+
+struct Pool : IPool {
+    Pool() { g_events.push_back("pool+"); }
+    ~Pool() override { g_events.push_back("pool-"); }
+};
+
+struct IShard {
+    virtual ~IShard() = default;
+    virtual const std::string& name() const = 0;
+};
+
+struct Shard : IShard {
+    std::string name_;
+    Shard(std::string_view key, IPool&) : name_(key) { g_events.push_back("shard+" + name_); }
+    ~Shard() override { g_events.push_back("shard-" + name_); }
+    const std::string& name() const override { return name_; }
+};
+
+struct PinnedShard : IShard {
+    std::string name_;
+    explicit PinnedShard(std::string_view key) : name_(key) {}
+    const std::string& name() const override { return name_; }
+};
+
+struct PrimaryShard : IShard {
+    std::string name_ = "primary (static)";
+    const std::string& name() const override { return name_; }
+};
+
+struct ITenantCache {
+    virtual ~ITenantCache() = default;
+};
+
+struct TenantCache : ITenantCache {
+    std::string tenant;
+    explicit TenantCache(std::string_view key) : tenant(key) { g_events.push_back("cache+" + tenant); }
+    ~TenantCache() override { g_events.push_back("cache-" + tenant); }
+};
+
+struct IRouter {
+    virtual ~IRouter() = default;
+};
+
+struct Router : IRouter {
+    explicit Router(IShard&) {}
+};
+
+// The "slow" member waits for the "fast" one to be built on another thread
+struct IWorker {
+    virtual ~IWorker() = default;
+};
+
+struct Worker : IWorker {
+    static inline std::promise<void>* slow_started = nullptr;
+    static inline std::promise<void>* fast_built = nullptr;
+    static inline std::shared_future<void> fast_ready;
+    static inline bool saw_fast = false;
+
+    explicit Worker(std::string_view key) {
+        if (key == "slow") {
+            slow_started->set_value();
+            saw_fast = fast_ready.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+        } else {
+            fast_built->set_value();
+        }
+    }
+};
+
+struct ISession {
+    virtual ~ISession() = default;
+};
+
+struct Session : ISession {
+    static inline std::atomic<int> alive{0};
+    explicit Session(std::string_view) { ++alive; }
+    ~Session() override { --alive; }
+};
+
+} // namespace
+
+TEST_CASE("a family creates one member per key on first use", "[family]") {
+    g_events.clear();
+    librtdi::registry reg;
+    reg.add_singleton<IPool, Pool>();
+    reg.add_singleton_family<IShard, Shard>(librtdi::deps<IPool>);
+    auto r = reg.build({.eager_singletons = false});
+
+    auto& a = r->get<IShard>("eu-1");
+    auto& b = r->get<IShard>("us-2");
+    REQUIRE(a.name() == "eu-1");
+    REQUIRE(b.name() == "us-2");
+    REQUIRE(&r->get<IShard>("eu-1") == &a);
+    REQUIRE(r->try_get<IShard>("ap-3") != nullptr);
+    REQUIRE(g_events == std::vector<std::string>{"pool+", "shard+eu-1", "shard+us-2", "shard+ap-3"});
+}
+
+TEST_CASE("a key with its own registration wins over the family", "[family]") {
+    librtdi::registry reg;
+    reg.add_singleton<IShard, PrimaryShard>("primary");
+    reg.add_singleton_family<IShard, PinnedShard>();
+    REQUIRE_THROWS_AS((reg.add_singleton<IShard, PrimaryShard>()), librtdi::duplicate_registration);
+    auto r = reg.build();
+
+    REQUIRE(r->get<IShard>("primary").name() == "primary (static)");
+    REQUIRE(r->get<IShard>("replica").name() == "replica");
+    REQUIRE_THROWS_AS(r->get<IShard>(), librtdi::di_error);
+    REQUIRE_THROWS_AS(r->get<ITenantCache>("t1"), librtdi::not_found);
+}
+
+TEST_CASE("family members are created once under concurrent first use", "[family]") {
+    librtdi::registry reg;
+    reg.add_singleton_family<IShard, PinnedShard>();
+    auto r = reg.build();
+
+    std::vector<std::thread> threads;
+    std::vector<const IShard*> seen(8);
+    for (std::size_t t = 0; t < seen.size(); ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 200; ++i) {
+                static_cast<void>(r->get<IShard>("k" + std::to_string(i % 16)));
+            }
+            seen[t] = &r->get<IShard>("k0");
+        });
+    }
+    for (auto& th : threads) th.join();
+    for (const auto* p : seen) REQUIRE(p == seen.front());
+}
+
+TEST_CASE("family members under different keys are built concurrently", "[family]") {
+    librtdi::registry reg;
+    reg.add_singleton_family<IWorker, Worker>();
+    auto r = reg.build();
+
+    std::promise<void> slow_started;
+    std::promise<void> fast_built;
+    Worker::slow_started = &slow_started;
+    Worker::fast_built = &fast_built;
+    Worker::fast_ready = fast_built.get_future().share();
+    Worker::saw_fast = false;
+
+    std::thread slow([&] { static_cast<void>(r->get<IWorker>("slow")); });
+    slow_started.get_future().wait();
+    static_cast<void>(r->get<IWorker>("fast"));
+    slow.join();
+    REQUIRE(Worker::saw_fast);
+}
+
+TEST_CASE("a capped family keeps at most max_instances members", "[family]") {
+    Session::alive = 0;
+    {
+        librtdi::registry reg;
+        reg.add_singleton_family<ISession, Session>(8);
+        auto r = reg.build();
+
+        int peak = 0;
+        for (int i = 0; i < 1000; ++i) {
+            static_cast<void>(r->acquire<ISession>("s" + std::to_string(i)));
+            peak = std::max(peak, Session::alive.load());
+        }
+        REQUIRE(peak == 8);
+        // Recently used members survive a burst of new keys
+        auto kept = r->acquire<ISession>("s999");
+        for (int i = 0; i < 7; ++i) {
+            static_cast<void>(r->acquire<ISession>("t" + std::to_string(i)));
+            static_cast<void>(r->acquire<ISession>("s999"));
+        }
+        REQUIRE(&*r->acquire<ISession>("s999") == &*kept);
+        REQUIRE(Session::alive == 8);
+    }
+    REQUIRE(Session::alive == 0);
+}
+
+TEST_CASE("a capped family evicts the least recently resolved member", "[family]") {
+    g_events.clear();
+    librtdi::registry reg;
+    reg.add_singleton_family<ITenantCache, TenantCache>(2);
+    auto r = reg.build();
+
+    REQUIRE_THROWS_AS(r->get<ITenantCache>("a"), librtdi::di_error);
+    auto a = r->acquire<ITenantCache>("a");
+    static_cast<void>(r->acquire<ITenantCache>("b"));
+    static_cast<void>(r->acquire<ITenantCache>("a"));   // b is now least recent
+    static_cast<void>(r->acquire<ITenantCache>("c"));
+    REQUIRE(g_events == std::vector<std::string>{"cache+a", "cache+b", "cache+c", "cache-b"});
+
+    // "a" is evicted by "d" but pinned by its guard until released
+    static_cast<void>(r->acquire<ITenantCache>("c"));
+    static_cast<void>(r->acquire<ITenantCache>("d"));
+    REQUIRE(g_events.back() == "cache+d");
+    REQUIRE(dynamic_cast<const TenantCache&>(*a).tenant == "a");
+    a = r->acquire<ITenantCache>("b");
+    REQUIRE(g_events == std::vector<std::string>{"cache+a", "cache+b", "cache+c", "cache-b",
+                                                 "cache+d", "cache+b", "cache-c", "cache-a"});
+}
+
+TEST_CASE("family members are torn down before their dependencies", "[family]") {
+    g_events.clear();
+    {
+        librtdi::registry reg;
+        reg.add_singleton<IPool, Pool>();
+        reg.add_singleton_family<IShard, Shard>(librtdi::deps<IPool>);
+        auto r = reg.build({.eager_singletons = false});
+        static_cast<void>(r->get<IShard>("a"));
+        static_cast<void>(r->get<IShard>("b"));
+    }
+    REQUIRE(g_events == std::vector<std::string>{"pool+", "shard+a", "shard+b",
+                                                 "shard-b", "shard-a", "pool-"});
+}
+
+TEST_CASE("a family cannot be injected without a key", "[family]") {
+    librtdi::registry reg;
+    reg.add_singleton_family<IShard, PinnedShard>();
+    reg.add_singleton<IRouter, Router>(librtdi::deps<IShard>);
+    REQUIRE_THROWS_AS(reg.build(), librtdi::lifetime_mismatch);
+}
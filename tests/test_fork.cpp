@@ -0,0 +1,216 @@
+#include <catch2/catch_test_macros.hpp>
+#include <librtdi.hpp>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#define LIBRTDI_TEST_HAS_FORK 1
+#endif
+
+namespace {
+
+static int g_pools_created = 0;
+static int g_pools_destroyed = 0;
+
+struct IConfig {
+    virtual ~IConfig() = default;
+};
+
+struct Config : IConfig {};
+
+struct IWorkerPool {
+    virtual ~IWorkerPool() = default;
+    virtual int generation() const = 0;
+};
+
+struct WorkerPool : IWorkerPool {
+    int generation_;
+    WorkerPool() : generation_(++g_pools_created) {}
+    ~WorkerPool() override { ++g_pools_destroyed; }
+    int generation() const override { return generation_; }
+};
+
+struct IService {
+    virtual ~IService() = default;
+    virtual IWorkerPool& pool() const = 0;
+};
+
+struct Service : IService {
+    IWorkerPool& pool_;
+    explicit Service(IWorkerPool& p) : pool_(p) {}
+    IWorkerPool& pool() const override { return pool_; }
+};
+
+struct IRequest {
+    virtual ~IRequest() = default;
+};
+
+struct Request : IRequest {
+    explicit Request(IWorkerPool&) {}
+};
+
+struct IHandler {
+    virtual ~IHandler() = default;
+};
+
+struct Handler : IHandler {
+    explicit Handler(std::vector<std::unique_ptr<IRequest>>) {}
+};
+
+struct IFeed {
+    virtual ~IFeed() = default;
+};
+
+// Every instance after the first blocks until `release` is ready
+struct Feed : IFeed {
+    static inline std::atomic<int> built{0};
+    static inline std::promise<void>* entered = nullptr;
+    static inline std::shared_future<void> release;
+
+    Feed() {
+        if (++built > 1) {
+            entered->set_value();
+            release.wait();
+        }
+    }
+};
+
+librtdi::registry make_registry() {
+    librtdi::registry reg;
+    reg.add_singleton<IConfig, Config>();
+    reg.add_singleton<IWorkerPool, WorkerPool>();
+    reg.add_singleton<IService, Service>(librtdi::deps<IWorkerPool>);
+    reg.set_fork_policy<IWorkerPool>(librtdi::fork_policy::reinitialize);
+    return reg;
+}
+
+} // namespace
+
+TEST_CASE("after_fork_child re-creates reinitialize singletons and their consumers", "[fork]") {
+    g_pools_created = 0;
+    g_pools_destroyed = 0;
+    auto r = make_registry().build();
+
+    auto* config = &r->get<IConfig>();
+    auto* service = &r->get<IService>();
+    REQUIRE(service->pool().generation() == 1);
+
+    r->prepare_fork();
+    r->after_fork_parent();
+    REQUIRE(&r->get<IService>() == service);
+
+    r->after_fork_child();
+
+    // Stale instance is leaked, not destroyed; eager mode rebuilt it
+    REQUIRE(g_pools_destroyed == 0);
+    REQUIRE(g_pools_created == 2);
+    REQUIRE(&r->get<IConfig>() == config);
+    REQUIRE(r->get<IWorkerPool>().generation() == 2);
+    REQUIRE(r->get<IService>().pool().generation() == 2);
+}
+
+TEST_CASE("after_fork_child follows dependencies through transients", "[fork]") {
+    librtdi::registry reg;
+    reg.add_singleton<IWorkerPool, WorkerPool>();
+    reg.add_collection<IRequest, Request>(librtdi::lifetime_kind::transient,
+                                          librtdi::deps<IWorkerPool>);
+    reg.add_singleton<IHandler, Handler>(
+        librtdi::deps<librtdi::collection<librtdi::transient<IRequest>>>);
+    reg.set_fork_policy<IWorkerPool>(librtdi::fork_policy::reinitialize);
+    auto r = reg.build();
+
+    auto* handler = &r->get<IHandler>();
+    r->after_fork_child();
+    REQUIRE(&r->get<IHandler>() != handler);
+}
+
+TEST_CASE("destroy_stale_on_fork destroys stale instances; replacements are created lazily", "[fork]") {
+    g_pools_created = 0;
+    g_pools_destroyed = 0;
+    auto r = make_registry().build({.eager_singletons = false,
+                                    .destroy_stale_on_fork = true});
+    REQUIRE(r->get<IService>().pool().generation() == 1);
+
+    r->after_fork_child();
+    REQUIRE(g_pools_destroyed == 1);
+    REQUIRE(g_pools_created == 1);
+
+    REQUIRE(r->get<IService>().pool().generation() == 2);
+}
+
+TEST_CASE("after_fork_child re-runs the startup phases", "[fork]") {
+    g_pools_created = 0;
+    auto reg = make_registry();
+    reg.set_startup_phase<IWorkerPool>("critical");
+    auto r = reg.build({.eager_singletons = false, .startup_phases = {"critical"}});
+    REQUIRE(g_pools_created == 1);
+
+    r->after_fork_child();
+
+    // Rebuilt by startup rather than on first use, with a fresh phase future
+    REQUIRE(g_pools_created == 2);
+    REQUIRE(r->phase_ready("critical").wait_for(std::chrono::seconds(0))
+            == std::future_status::ready);
+    REQUIRE(r->get<IWorkerPool>().generation() == 2);
+}
+
+TEST_CASE("prepare_fork waits for a refresh in flight", "[fork]") {
+    using namespace std::chrono_literals;
+    Feed::built = 0;
+    librtdi::registry reg;
+    reg.add_refreshable<IFeed, Feed>();
+    auto r = reg.build();
+
+    std::promise<void> entered;
+    std::promise<void> release;
+    Feed::entered = &entered;
+    Feed::release = release.get_future().share();
+
+    std::thread refresher([&] { r->refresh<IFeed>(); });
+    entered.get_future().wait();
+
+    // The refresh holds its slot's writer lock: fork() must not copy that
+    auto forking = std::async(std::launch::async, [&] {
+        r->prepare_fork();
+        r->after_fork_parent();
+    });
+    REQUIRE(forking.wait_for(50ms) == std::future_status::timeout);
+
+    release.set_value();
+    forking.get();
+    refresher.join();
+    REQUIRE(Feed::built == 2);
+}
+
+#ifdef LIBRTDI_TEST_HAS_FORK
+TEST_CASE("forked child gets fresh per-process singletons", "[fork]") {
+    g_pools_created = 0;
+    g_pools_destroyed = 0;
+    auto r = make_registry().build();
+    auto* config = &r->get<IConfig>();
+
+    r->prepare_fork();
+    pid_t pid = fork();
+    REQUIRE(pid >= 0);
+    if (pid == 0) {
+        r->after_fork_child();
+        bool ok = &r->get<IConfig>() == config
+               && r->get<IService>().pool().generation() == 2
+               && g_pools_destroyed == 0;
+        _exit(ok ? 0 : 1);
+    }
+    r->after_fork_parent();
+
+    int status = 0;
+    REQUIRE(waitpid(pid, &status, 0) == pid);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(WEXITSTATUS(status) == 0);
+    REQUIRE(r->get<IService>().pool().generation() == 1);
+}
+#endif
@@ -1,5 +1,6 @@
 #include <catch2/catch_test_macros.hpp>
 #include <librtdi.hpp>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -32,6 +33,102 @@ TEST_CASE("forward singleton slot", "[forward]") {
     REQUIRE(&static_cast<IBase&>(derived) == &base);
 }
 
+TEST_CASE("forward singleton aliases the target instance through a non-primary base",
+          "[forward]") {
+    struct IFirst {
+        virtual ~IFirst() = default;
+        int first_payload = 1;
+    };
+    struct ISecond {
+        virtual ~ISecond() = default;
+        virtual int second() const = 0;
+    };
+    struct Both : IFirst, ISecond {
+        int second() const override { return 2; }
+    };
+
+    librtdi::registry reg;
+    reg.add_singleton<Both, Both>();
+    reg.forward<ISecond, Both>();
+    reg.forward<IFirst, Both>();
+    auto r = reg.build({.eager_singletons = false});
+
+    // Resolving the alias first creates the target exactly once
+    auto& second = r->get<ISecond>();
+    auto& both = r->get<Both>();
+    REQUIRE(&second == static_cast<ISecond*>(&both));
+    REQUIRE(&r->get<IFirst>() == static_cast<IFirst*>(&both));
+    REQUIRE(&r->get<ISecond>() == &second);
+    REQUIRE(second.second() == 2);
+}
+
+TEST_CASE("forward casts through non-virtual and virtual bases", "[forward]") {
+    struct IPad {
+        virtual ~IPad() = default;
+        long pad = 0;
+    };
+    struct IShared {
+        virtual ~IShared() = default;
+        virtual int id() const = 0;
+    };
+    struct Left : virtual IShared {};
+    struct Right : virtual IShared {};
+    struct Diamond : IPad, Left, Right {
+        int id_;
+        explicit Diamond(int id) : id_(id) {}
+        Diamond() : Diamond(7) {}
+        int id() const override { return id_; }
+    };
+    struct Plain : IPad, IShared {
+        int id() const override { return 9; }
+    };
+
+    librtdi::registry reg;
+    reg.add_transient<Diamond, Diamond>();
+    reg.forward<IShared, Diamond>();   // virtual base: function-pointer cast
+    reg.add_transient<Plain, Plain>();
+    reg.forward<IPad, Plain>();        // non-virtual base: memoized offset
+    auto r = reg.build();
+
+    for (int i = 0; i < 3; ++i) {
+        auto shared = r->create<IShared>();
+        REQUIRE(shared->id() == 7);
+        REQUIRE(dynamic_cast<Diamond*>(shared.get()) != nullptr);
+
+        auto pad = r->create<IPad>();
+        REQUIRE(dynamic_cast<Plain*>(pad.get()) != nullptr);
+        REQUIRE(dynamic_cast<Plain*>(pad.get())->id() == 9);
+    }
+}
+
+TEST_CASE("forward_cast_fn modes", "[forward]") {
+    struct A { virtual ~A() = default; int a = 1; };
+    struct B { virtual ~B() = default; int b = 2; };
+    struct C : A, B {};
+
+    librtdi::forward_cast_fn::function_ptr to_b = [](void* p) -> void* {
+        return static_cast<B*>(static_cast<C*>(p));
+    };
+
+    C c1;
+    C c2;
+    auto offset = librtdi::forward_cast_fn::constant_offset(to_b);
+    REQUIRE(offset(&c1) == static_cast<B*>(&c1));
+    REQUIRE(offset(&c2) == static_cast<B*>(&c2));   // reuses the learned offset
+    REQUIRE(offset(nullptr) == nullptr);
+
+    auto copy = offset;
+    REQUIRE(copy(&c2) == static_cast<B*>(&c2));
+
+    auto fn = librtdi::forward_cast_fn::function(to_b);
+    REQUIRE(fn(&c1) == static_cast<B*>(&c1));
+
+    librtdi::forward_cast_fn callable{std::function<void*(void*)>{to_b}};
+    REQUIRE(callable(&c1) == static_cast<B*>(&c1));
+
+    REQUIRE_FALSE(librtdi::forward_cast_fn{});
+}
+
 TEST_CASE("forward transient slot", "[forward]") {
     librtdi::registry reg;
     reg.add_transient<IDerived, Impl>();
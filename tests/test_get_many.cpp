@@ -0,0 +1,198 @@
+#include <catch2/catch_test_macros.hpp>
+#include <librtdi.hpp>
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+struct IConfig {
+    virtual ~IConfig() = default;
+};
+
+struct Config : IConfig {};
+
+struct IRequest {
+    virtual ~IRequest() = default;
+};
+
+struct Request : IRequest {};
+
+struct IPlugin {
+    virtual ~IPlugin() = default;
+    virtual int id() const = 0;
+};
+
+struct PluginA : IPlugin {
+    int id() const override { return 1; }
+};
+
+struct PluginB : IPlugin {
+    int id() const override { return 2; }
+};
+
+struct IHandler {
+    virtual ~IHandler() = default;
+};
+
+struct Handler : IHandler {};
+
+struct IMissing {
+    virtual ~IMissing() = default;
+};
+
+// Blocks in its constructor until released
+struct IGate {
+    virtual ~IGate() = default;
+};
+
+struct Gate : IGate {
+    static inline std::promise<void> entered;
+    static inline std::shared_future<void> release;
+    Gate() {
+        entered.set_value();
+        release.wait();
+    }
+};
+
+librtdi::registry make_registry() {
+    librtdi::registry reg;
+    reg.add_singleton<IConfig, Config>();
+    reg.add_transient<IRequest, Request>();
+    reg.add_collection<IPlugin, PluginA>(librtdi::lifetime_kind::singleton);
+    reg.add_collection<IPlugin, PluginB>(librtdi::lifetime_kind::singleton);
+    reg.add_collection<IHandler, Handler>(librtdi::lifetime_kind::transient);
+    reg.add_collection<IHandler, Handler>(librtdi::lifetime_kind::transient);
+    return reg;
+}
+
+} // namespace
+
+TEST_CASE("get_many resolves every dependency kind", "[get_many]") {
+    auto r = make_registry().build();
+
+    auto [config, request, plugins, handlers] =
+        r->get_many<IConfig,
+                    librtdi::transient<IRequest>,
+                    librtdi::collection<IPlugin>,
+                    librtdi::collection<librtdi::transient<IHandler>>>();
+
+    REQUIRE(&config == &r->get<IConfig>());
+    REQUIRE(request != nullptr);
+    REQUIRE(plugins.size() == 2);
+    REQUIRE(plugins[0]->id() == 1);
+    REQUIRE(plugins[1]->id() == 2);
+    REQUIRE(handlers.size() == 2);
+    REQUIRE(handlers[0] != nullptr);
+}
+
+TEST_CASE("get_many matches individual resolution and reuses its plan", "[get_many]") {
+    auto r = make_registry().build({.eager_singletons = false});
+
+    for (int i = 0; i < 3; ++i) {
+        auto result = r->get_many<IConfig, librtdi::collection<IPlugin>>();
+        REQUIRE(&std::get<0>(result) == &r->get<IConfig>());
+        REQUIRE(std::get<1>(result) == r->get_all<IPlugin>());
+    }
+
+    // Transients are fresh on every call
+    auto first = std::get<0>(r->get_many<librtdi::transient<IRequest>>());
+    auto second = std::get<0>(r->get_many<librtdi::transient<IRequest>>());
+    REQUIRE(first.get() != second.get());
+}
+
+TEST_CASE("get_many reports missing slots like get/create", "[get_many]") {
+    auto r = make_registry().build();
+
+    REQUIRE_THROWS_AS((r->get_many<IConfig, IMissing>()), librtdi::not_found);
+    REQUIRE_THROWS_AS(r->get_many<librtdi::transient<IMissing>>(), librtdi::not_found);
+
+    // Unregistered collections resolve to empty vectors
+    auto [missing] = r->get_many<librtdi::collection<IMissing>>();
+    REQUIRE(missing.empty());
+
+    // Wrong slot carries the usual hint
+    try {
+        r->get_many<IRequest>();
+        FAIL("expected not_found");
+    } catch (const librtdi::not_found& e) {
+        REQUIRE(std::string(e.what()).find("create<T>()") != std::string::npos);
+    }
+}
+
+TEST_CASE("get_many with an empty type list", "[get_many]") {
+    auto r = make_registry().build();
+    [[maybe_unused]] std::tuple<> none = r->get_many<>();
+}
+
+TEST_CASE("get_many is safe under concurrent first use", "[get_many]") {
+    auto r = make_registry().build({.eager_singletons = false});
+
+    std::vector<IConfig*> seen(8, nullptr);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < seen.size(); ++i) {
+        threads.emplace_back([&, i] {
+            auto [config, plugins] = r->get_many<IConfig, librtdi::collection<IPlugin>>();
+            seen[i] = &config;
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    for (auto* p : seen) {
+        REQUIRE(p == &r->get<IConfig>());
+    }
+}
+
+TEST_CASE("get_many builds transients without holding the singleton lock", "[get_many]") {
+    auto reg = make_registry();
+    reg.add_transient<IGate, Gate>();
+    auto r = reg.build();
+
+    Gate::entered = {};
+    std::promise<void> release;
+    Gate::release = release.get_future().share();
+
+    std::thread slow([&] {
+        static_cast<void>(r->get_many<IConfig, librtdi::transient<IGate>>());
+    });
+    Gate::entered.get_future().wait();
+
+    // A cached singleton is served while the transient is still being built
+    auto cached = std::async(std::launch::async, [&] { return &r->get<IConfig>(); });
+    auto status = cached.wait_for(std::chrono::seconds(5));
+    release.set_value();
+    slow.join();
+    REQUIRE(status == std::future_status::ready);
+    REQUIRE(cached.get() == &r->get<IConfig>());
+}
+
+TEST_CASE("get_many with only transient slots does not wait for the singleton lock",
+          "[get_many]") {
+    auto reg = make_registry();
+    reg.add_singleton<IGate, Gate>();
+    auto r = reg.build({.eager_singletons = false});
+
+    Gate::entered = {};
+    std::promise<void> release;
+    Gate::release = release.get_future().share();
+
+    // The singleton factory runs under the resolver lock
+    std::thread slow([&] { static_cast<void>(r->get<IGate>()); });
+    Gate::entered.get_future().wait();
+
+    auto batch = std::async(std::launch::async, [&] {
+        auto [request, handlers] = r->get_many<librtdi::transient<IRequest>,
+                                               librtdi::collection<librtdi::transient<IHandler>>>();
+        return request != nullptr && handlers.size() == 2;
+    });
+    auto status = batch.wait_for(std::chrono::seconds(5));
+    release.set_value();
+    slow.join();
+    REQUIRE(status == std::future_status::ready);
+    REQUIRE(batch.get());
+}
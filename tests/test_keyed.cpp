@@ -1,5 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
 #include <librtdi.hpp>
+
+#include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace {
@@ -182,3 +186,141 @@ TEST_CASE("keyed singleton destruction order destroys consumer before dependency
         "dependency destroyed",
     });
 }
+
+namespace {
+
+struct IPicker {
+    virtual ~IPicker() = default;
+    virtual int sum() const = 0;
+};
+
+struct Picker : IPicker {
+    int sum_;
+    Picker(IService& a, std::unique_ptr<IService> b, std::vector<IService*> pool)
+        : sum_(a.value() + b->value() * 10 + static_cast<int>(pool.size()) * 100) {}
+    int sum() const override { return sum_; }
+};
+
+struct IChain {
+    virtual ~IChain() = default;
+};
+
+struct ChainA : IChain {
+    explicit ChainA(IChain&) {}
+};
+
+struct ChainB : IChain {};
+
+struct IShard {
+    virtual ~IShard() = default;
+    virtual std::string_view name() const = 0;
+};
+
+struct Shard : IShard {
+    std::string name_;
+    explicit Shard(std::string_view key) : name_(key) {}
+    std::string_view name() const override { return name_; }
+};
+
+struct IRouter {
+    virtual ~IRouter() = default;
+};
+
+struct Router : IRouter {
+    IShard& shard;
+    explicit Router(IShard& s) : shard(s) {}
+};
+
+} // namespace
+
+TEST_CASE("keyed<T, Key> dependencies resolve under their key", "[keyed][deps]") {
+    librtdi::registry reg;
+    reg.add_singleton<IService, DefaultService>();
+    reg.add_singleton<IService, ServiceA>("a");
+    reg.add_transient<IService, ServiceB>("b");
+    reg.add_collection<IService, ServiceA>("pool", librtdi::lifetime_kind::singleton);
+    reg.add_collection<IService, ServiceB>("pool", librtdi::lifetime_kind::singleton);
+    reg.add_transient<IPicker, Picker>(librtdi::deps<librtdi::keyed<IService, "a">,
+                                                      librtdi::keyed<librtdi::transient<IService>, "b">,
+                                                      librtdi::keyed<librtdi::collection<IService>, "pool">>);
+    auto r = reg.build();
+
+    REQUIRE(r->create<IPicker>()->sum() == 221);
+    auto [a, b] = r->get_many<librtdi::keyed<IService, "a">, IService>();
+    REQUIRE(a.value() == 1);
+    REQUIRE(b.value() == 0);
+}
+
+TEST_CASE("a missing keyed dependency fails validation with its key", "[keyed][deps]") {
+    librtdi::registry reg;
+    reg.add_singleton<IService, ServiceA>("a");
+    reg.add_singleton<IChain, ChainA>(librtdi::deps<librtdi::keyed<IChain, "missing">>);
+    try {
+        static_cast<void>(reg.build());
+        FAIL("build() should throw");
+    } catch (const librtdi::not_found& e) {
+        REQUIRE(std::string(e.what()).find("missing") != std::string::npos);
+    }
+}
+
+TEST_CASE("keyed edges take part in cycle detection", "[keyed][deps]") {
+    SECTION("the same type under another key is a different node") {
+        librtdi::registry reg;
+        reg.add_singleton<IChain, ChainA>("a", librtdi::deps<librtdi::keyed<IChain, "b">>);
+        reg.add_singleton<IChain, ChainB>("b");
+        auto r = reg.build();
+        REQUIRE_NOTHROW(r->get<IChain>("a"));
+    }
+    SECTION("a keyed edge back to the start is a cycle") {
+        librtdi::registry reg;
+        reg.add_singleton<IChain, ChainA>("a", librtdi::deps<librtdi::keyed<IChain, "b">>);
+        reg.add_singleton<IChain, ChainA>("b", librtdi::deps<librtdi::keyed<IChain, "a">>);
+        REQUIRE_THROWS_AS(reg.build(), librtdi::cyclic_dependency);
+    }
+}
+
+TEST_CASE("a keyed dependency binds to a family member", "[keyed][deps]") {
+    librtdi::registry reg;
+    reg.add_singleton_family<IShard, Shard>();
+    reg.add_singleton<IRouter, Router>(librtdi::deps<librtdi::keyed<IShard, "eu-1">>);
+    auto r = reg.build();
+
+    REQUIRE(static_cast<Router&>(r->get<IRouter>()).shard.name() == "eu-1");
+    REQUIRE(&static_cast<Router&>(r->get<IRouter>()).shard == &r->get<IShard>("eu-1"));
+}
+
+TEST_CASE("a keyed dependency on a capped family is rejected", "[keyed][deps]") {
+    librtdi::registry reg;
+    reg.add_singleton_family<IShard, Shard>(4);
+    reg.add_singleton<IRouter, Router>(librtdi::deps<librtdi::keyed<IShard, "eu-1">>);
+    REQUIRE_THROWS_AS(reg.build(), librtdi::lifetime_mismatch);
+}
+
+TEST_CASE("keyed dependencies order teardown", "[keyed][deps][destruction]") {
+    static std::vector<std::string> events;
+    events.clear();
+
+    struct ILog {
+        virtual ~ILog() = default;
+    };
+    struct Log : ILog {
+        ~Log() override { events.push_back("log"); }
+    };
+    struct IAudit {
+        virtual ~IAudit() = default;
+    };
+    struct Audit : IAudit {
+        explicit Audit(ILog&) {}
+        ~Audit() override { events.push_back("audit"); }
+    };
+
+    {
+        librtdi::registry reg;
+        reg.add_singleton<ILog, Log>("audit");
+        reg.add_singleton<IAudit, Audit>(librtdi::deps<librtdi::keyed<ILog, "audit">>);
+        reg.set_startup_phase<IAudit>("first");
+        auto r = reg.build({.startup_phases = {"first"}});
+        REQUIRE(r->phase_ready("first").valid());
+    }
+    REQUIRE(events == std::vector<std::string>{"audit", "log"});
+}
@@ -417,3 +417,113 @@ TEST_CASE("singleton teardown fallback destroys each created instance once",
     REQUIRE(derived_destructions == 1);
     REQUIRE(consumer_destructions == 1);
 }
+
+TEST_CASE("exit_policy leak skips the singleton destructor",
+          "[lifetime][destruction][exit_policy]") {
+    static int cache_destructions = 0;
+    static int logger_destructions = 0;
+    cache_destructions = 0;
+    logger_destructions = 0;
+
+    struct ICache {
+        virtual ~ICache() = default;
+    };
+
+    struct BigCache final : ICache {
+        ~BigCache() override { ++cache_destructions; }
+    };
+
+    struct ILogger {
+        virtual ~ILogger() = default;
+    };
+
+    struct Logger final : ILogger {
+        ~Logger() override { ++logger_destructions; }
+    };
+
+    {
+        librtdi::registry reg;
+        reg.add_singleton<ICache, BigCache>();
+        reg.add_singleton<ILogger, Logger>();
+        reg.set_exit_policy<ICache>(librtdi::exit_policy::leak);
+        auto r = reg.build();
+    }
+
+    REQUIRE(cache_destructions == 0);
+    REQUIRE(logger_destructions == 1);
+}
+
+TEST_CASE("fast_exit only destroys singletons marked destroy, in dependency order",
+          "[lifetime][destruction][exit_policy]") {
+    static std::vector<std::string> events;
+    events.clear();
+
+    struct ISocket {
+        virtual ~ISocket() = default;
+    };
+
+    struct Socket final : ISocket {
+        ~Socket() override { events.push_back("socket closed"); }
+    };
+
+    struct IFlusher {
+        virtual ~IFlusher() = default;
+    };
+
+    struct Flusher final : IFlusher {
+        explicit Flusher(ISocket&) {}
+        ~Flusher() override { events.push_back("flushed"); }
+    };
+
+    struct ICache {
+        virtual ~ICache() = default;
+    };
+
+    struct Cache final : ICache {
+        explicit Cache(ISocket&) {}
+        ~Cache() override { events.push_back("cache freed"); }
+    };
+
+    {
+        librtdi::registry reg;
+        reg.add_singleton<ISocket, Socket>();
+        reg.add_singleton<IFlusher, Flusher>(librtdi::deps<ISocket>);
+        reg.add_singleton<ICache, Cache>(librtdi::deps<ISocket>);
+        reg.set_exit_policy<ISocket>(librtdi::exit_policy::destroy);
+        reg.set_exit_policy<IFlusher>(librtdi::exit_policy::destroy);
+        auto r = reg.build({.fast_exit = true});
+    }
+
+    REQUIRE(events == std::vector<std::string>{"flushed", "socket closed"});
+}
+
+TEST_CASE("set_exit_policy_target only affects the targeted impl",
+          "[lifetime][destruction][exit_policy]") {
+    static int a_destructions = 0;
+    static int b_destructions = 0;
+    a_destructions = 0;
+    b_destructions = 0;
+
+    struct IPlugin {
+        virtual ~IPlugin() = default;
+    };
+
+    struct PluginA final : IPlugin {
+        ~PluginA() override { ++a_destructions; }
+    };
+
+    struct PluginB final : IPlugin {
+        ~PluginB() override { ++b_destructions; }
+    };
+
+    {
+        librtdi::registry reg;
+        reg.add_collection<IPlugin, PluginA>(librtdi::lifetime_kind::singleton);
+        reg.add_collection<IPlugin, PluginB>(librtdi::lifetime_kind::singleton);
+        reg.set_exit_policy_target<IPlugin, PluginB>(librtdi::exit_policy::leak);
+        auto r = reg.build();
+    }
+
+    REQUIRE(a_destructions == 1);
+    REQUIRE(b_destructions == 0);
+}
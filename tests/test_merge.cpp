@@ -0,0 +1,129 @@
+#include <catch2/catch_test_macros.hpp>
+#include <librtdi.hpp>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct IPlugin {
+    virtual ~IPlugin() = default;
+    virtual std::string name() const = 0;
+};
+
+struct PluginA : IPlugin { std::string name() const override { return "A"; } };
+struct PluginB : IPlugin { std::string name() const override { return "B"; } };
+struct PluginC : IPlugin { std::string name() const override { return "C"; } };
+
+struct IService {
+    virtual ~IService() = default;
+    virtual std::string tag() const = 0;
+};
+
+struct Service : IService {
+    std::string tag() const override { return "svc"; }
+};
+
+struct IDerivedService : IService {};
+
+struct DerivedService : IDerivedService {
+    std::string tag() const override { return "derived"; }
+};
+
+struct Tagged : IService {
+    librtdi::decorated_ptr<IService> inner_;
+    explicit Tagged(librtdi::decorated_ptr<IService> inner) : inner_(std::move(inner)) {}
+    std::string tag() const override { return "[" + inner_->tag() + "]"; }
+};
+
+template <int N>
+struct Module {
+    virtual ~Module() = default;
+};
+
+template <int N>
+struct ModuleImpl : Module<N> {};
+
+template <int... Ns>
+void register_modules(librtdi::registry& reg, std::integer_sequence<int, Ns...>) {
+    (reg.add_singleton<Module<Ns>, ModuleImpl<Ns>>(), ...);
+}
+
+} // namespace
+
+TEST_CASE("merge appends collections in merge order", "[merge]") {
+    librtdi::registry root;
+    root.add_collection<IPlugin, PluginA>(librtdi::lifetime_kind::singleton);
+
+    librtdi::registry m1;
+    m1.add_collection<IPlugin, PluginB>(librtdi::lifetime_kind::singleton);
+    librtdi::registry m2;
+    m2.add_collection<IPlugin, PluginC>(librtdi::lifetime_kind::singleton);
+
+    root.merge(std::move(m1)).merge(std::move(m2));
+    REQUIRE(m1.descriptors().empty());
+
+    auto r = root.build();
+    auto all = r->get_all<IPlugin>();
+    REQUIRE(all.size() == 3);
+    REQUIRE(all[0]->name() == "A");
+    REQUIRE(all[1]->name() == "B");
+    REQUIRE(all[2]->name() == "C");
+}
+
+TEST_CASE("merge detects duplicate single slots and leaves both registries intact", "[merge]") {
+    librtdi::registry root;
+    root.add_singleton<IService, Service>();
+
+    librtdi::registry module;
+    module.add_collection<IPlugin, PluginA>(librtdi::lifetime_kind::singleton);
+    module.add_singleton<IService, Service>();
+
+    REQUIRE_THROWS_AS(root.merge(std::move(module)), librtdi::duplicate_registration);
+    REQUIRE(root.descriptors().size() == 1);
+    REQUIRE(module.descriptors().size() == 2);
+
+    // Same type under a different lifetime or key is a different slot
+    librtdi::registry other;
+    other.add_transient<IService, Service>();
+    other.add_singleton<IService, Service>("alt");
+    REQUIRE_NOTHROW(root.merge(std::move(other)));
+    REQUIRE_THROWS_AS((root.add_singleton<IService, Service>()), librtdi::duplicate_registration);
+}
+
+TEST_CASE("merge applies forwards and decorators across modules", "[merge]") {
+    librtdi::registry root;
+    root.add_singleton<IDerivedService, DerivedService>();
+
+    librtdi::registry forwarding;
+    forwarding.forward<IService, IDerivedService>();
+    librtdi::registry decorating;
+    decorating.decorate<IService, Tagged>();
+
+    root.merge(std::move(forwarding)).merge(std::move(decorating));
+    auto r = root.build();
+    REQUIRE(r->get<IService>().tag() == "[derived]");
+}
+
+TEST_CASE("module registries can be filled concurrently and merged", "[merge]") {
+    librtdi::registry a;
+    librtdi::registry b;
+    std::thread ta([&] { register_modules(a, std::integer_sequence<int, 0, 1, 2, 3, 4>{}); });
+    std::thread tb([&] { register_modules(b, std::integer_sequence<int, 5, 6, 7, 8, 9>{}); });
+    ta.join();
+    tb.join();
+
+    librtdi::registry root;
+    root.merge(std::move(a)).merge(std::move(b));
+    auto r = root.build();
+    REQUIRE(r->try_get<Module<0>>() != nullptr);
+    REQUIRE(r->try_get<Module<9>>() != nullptr);
+}
+
+TEST_CASE("merge after build throws", "[merge]") {
+    librtdi::registry root;
+    auto r = root.build();
+    librtdi::registry module;
+    REQUIRE_THROWS_AS(root.merge(std::move(module)), librtdi::di_error);
+}
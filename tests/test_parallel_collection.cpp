@@ -0,0 +1,221 @@
+#include <catch2/catch_test_macros.hpp>
+#include <librtdi.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Spawns one thread per task; joins them on destruction.
+class thread_executor {
+public:
+    ~thread_executor() { join(); }
+
+    librtdi::task_executor as_executor() {
+        return [this](std::function<void()> task) {
+            std::lock_guard lock(mutex_);
+            threads_.emplace_back(std::move(task));
+        };
+    }
+
+    void join() {
+        std::lock_guard lock(mutex_);
+        for (auto& t : threads_) {
+            if (t.joinable()) t.join();
+        }
+        threads_.clear();
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::thread> threads_;
+};
+
+std::atomic<int> g_active{0};
+std::atomic<int> g_max_active{0};
+
+void track_concurrency() {
+    int now = ++g_active;
+    int seen = g_max_active.load();
+    while (now > seen && !g_max_active.compare_exchange_weak(seen, now)) {}
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    --g_active;
+}
+
+void reset_tracking() {
+    g_active = 0;
+    g_max_active = 0;
+}
+
+struct IHandler {
+    virtual ~IHandler() = default;
+    virtual int id() const = 0;
+};
+
+template <int N>
+struct SlowHandler : IHandler {
+    SlowHandler() { track_concurrency(); }
+    int id() const override { return N; }
+};
+
+std::atomic<int> g_constructed{0};
+
+template <int N>
+struct CountedHandler : IHandler {
+    CountedHandler() {
+        ++g_constructed;
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    }
+    int id() const override { return N; }
+};
+
+struct FailingHandler : IHandler {
+    FailingHandler() { throw std::runtime_error("handler failed"); }
+    int id() const override { return -1; }
+};
+
+struct IConfig {
+    virtual ~IConfig() = default;
+};
+
+struct Config : IConfig {};
+
+template <int N>
+struct ConfiguredHandler : IHandler {
+    IConfig& config;
+    explicit ConfiguredHandler(IConfig& c) : config(c) { track_concurrency(); }
+    int id() const override { return N; }
+};
+
+librtdi::registry make_slow_collection(librtdi::lifetime_kind lt) {
+    librtdi::registry reg;
+    reg.add_collection<IHandler, SlowHandler<1>>(lt);
+    reg.add_collection<IHandler, SlowHandler<2>>(lt);
+    reg.add_collection<IHandler, SlowHandler<3>>(lt);
+    reg.add_collection<IHandler, SlowHandler<4>>(lt);
+    return reg;
+}
+
+std::vector<int> ids_of(const auto& handlers) {
+    std::vector<int> ids;
+    for (const auto& h : handlers) ids.push_back(h->id());
+    return ids;
+}
+
+} // namespace
+
+TEST_CASE("get_all with an executor builds members in parallel, in order", "[parallel]") {
+    reset_tracking();
+    auto r = make_slow_collection(librtdi::lifetime_kind::singleton)
+                 .build({.eager_singletons = false});
+    thread_executor pool;
+
+    auto handlers = r->get_all<IHandler>(pool.as_executor());
+    REQUIRE(ids_of(handlers) == std::vector<int>{1, 2, 3, 4});
+    REQUIRE(g_max_active > 1);
+
+    // Cached: later calls return the same instances without the executor
+    REQUIRE(r->get_all<IHandler>() == handlers);
+}
+
+TEST_CASE("create_all with an executor builds fresh members in parallel", "[parallel]") {
+    reset_tracking();
+    auto r = make_slow_collection(librtdi::lifetime_kind::transient).build();
+    thread_executor pool;
+
+    auto first = r->create_all<IHandler>(pool.as_executor());
+    auto second = r->create_all<IHandler>(pool.as_executor());
+    REQUIRE(ids_of(first) == std::vector<int>{1, 2, 3, 4});
+    REQUIRE(first[0].get() != second[0].get());
+    REQUIRE(g_max_active > 1);
+}
+
+TEST_CASE("build_options::collection_executor is the default for get_all", "[parallel]") {
+    reset_tracking();
+    thread_executor pool;
+    auto r = make_slow_collection(librtdi::lifetime_kind::singleton)
+                 .build({.eager_singletons = false,
+                         .collection_executor = pool.as_executor()});
+
+    REQUIRE(ids_of(r->get_all<IHandler>()) == std::vector<int>{1, 2, 3, 4});
+    REQUIRE(g_max_active > 1);
+}
+
+TEST_CASE("parallel members share their singleton dependencies", "[parallel]") {
+    reset_tracking();
+    librtdi::registry reg;
+    reg.add_singleton<IConfig, Config>();
+    reg.add_collection<IHandler, ConfiguredHandler<1>>(librtdi::lifetime_kind::singleton,
+                                                       librtdi::deps<IConfig>);
+    reg.add_collection<IHandler, ConfiguredHandler<2>>(librtdi::lifetime_kind::singleton,
+                                                       librtdi::deps<IConfig>);
+    reg.add_collection<IHandler, ConfiguredHandler<3>>(librtdi::lifetime_kind::singleton,
+                                                       librtdi::deps<IConfig>);
+    auto r = reg.build({.eager_singletons = false});
+    thread_executor pool;
+
+    auto handlers = r->get_all<IHandler>(pool.as_executor());
+    REQUIRE(handlers.size() == 3);
+    for (auto* h : handlers) {
+        REQUIRE(&static_cast<ConfiguredHandler<1>*>(h)->config == &r->get<IConfig>());
+    }
+}
+
+TEST_CASE("a failing member is reported; the others stay cached", "[parallel]") {
+    reset_tracking();
+    librtdi::registry reg;
+    reg.add_collection<IHandler, SlowHandler<1>>(librtdi::lifetime_kind::singleton);
+    reg.add_collection<IHandler, FailingHandler>(librtdi::lifetime_kind::singleton);
+    reg.add_collection<IHandler, SlowHandler<3>>(librtdi::lifetime_kind::singleton);
+    auto r = reg.build({.eager_singletons = false});
+    thread_executor pool;
+
+    REQUIRE_THROWS_AS(r->get_all<IHandler>(pool.as_executor()), librtdi::resolution_error);
+    pool.join();
+
+    reset_tracking();
+    REQUIRE_THROWS_AS(r->get_all<IHandler>(), librtdi::resolution_error);
+    REQUIRE(g_max_active == 0);   // members 1 and 3 were not rebuilt
+}
+
+TEST_CASE("an inline executor behaves like sequential resolution", "[parallel]") {
+    auto r = make_slow_collection(librtdi::lifetime_kind::singleton)
+                 .build({.eager_singletons = false});
+    librtdi::task_executor inline_executor = [](std::function<void()> task) { task(); };
+
+    REQUIRE(ids_of(r->get_all<IHandler>(inline_executor)) == std::vector<int>{1, 2, 3, 4});
+    REQUIRE(ids_of(r->create_all<IHandler>(inline_executor)).empty());
+}
+
+TEST_CASE("concurrent parallel get_all builds each member once", "[parallel]") {
+    g_constructed = 0;
+    librtdi::registry reg;
+    reg.add_collection<IHandler, CountedHandler<1>>(librtdi::lifetime_kind::singleton);
+    reg.add_collection<IHandler, CountedHandler<2>>(librtdi::lifetime_kind::singleton);
+    reg.add_collection<IHandler, CountedHandler<3>>(librtdi::lifetime_kind::singleton);
+    auto r = reg.build({.eager_singletons = false});
+    thread_executor pool;
+
+    std::vector<std::vector<IHandler*>> seen(4);
+    std::vector<std::thread> callers;
+    for (std::size_t i = 0; i < seen.size(); ++i) {
+        callers.emplace_back([&, i] {
+            // Half of the callers resolve sequentially and wait for the others
+            seen[i] = i % 2 == 0 ? r->get_all<IHandler>(pool.as_executor())
+                                 : r->get_all<IHandler>();
+        });
+    }
+    for (auto& t : callers) t.join();
+
+    REQUIRE(g_constructed == 3);
+    for (const auto& handlers : seen) {
+        REQUIRE(handlers == seen.front());
+    }
+}
@@ -0,0 +1,88 @@
+#include <catch2/catch_test_macros.hpp>
+#include <librtdi.hpp>
+
+#include "plugins/codec_plugin_api.hpp"
+
+#include <string>
+
+#if !defined(_WIN32) && !defined(__CYGWIN__)
+#include <dlfcn.h>
+#endif
+
+namespace {
+
+struct Dictionary : plugin_test::IDictionary {
+    std::string word() const override { return "dict"; }
+};
+
+bool plugin_loaded() {
+#if !defined(_WIN32) && !defined(__CYGWIN__)
+    void* h = dlopen(LIBRTDI_TEST_PLUGIN_PATH, RTLD_NOW | RTLD_NOLOAD);
+    if (h) dlclose(h);
+    return h != nullptr;
+#else
+    return true;
+#endif
+}
+
+} // namespace
+
+TEST_CASE("plugin factory is loaded on first resolution", "[plugin]") {
+    // Another test case may have loaded it already; build() must not.
+    const bool loaded_before = plugin_loaded();
+
+    librtdi::registry reg;
+    reg.add_singleton<plugin_test::IDictionary, Dictionary>();
+    reg.add_plugin<plugin_test::ICodec>(librtdi::lifetime_kind::singleton,
+                                        LIBRTDI_TEST_PLUGIN_PATH, "make_gzip_codec",
+                                        librtdi::deps<plugin_test::IDictionary>);
+    auto r = reg.build({.eager_singletons = false});
+    REQUIRE(plugin_loaded() == loaded_before);
+
+    auto& codec = r->get<plugin_test::ICodec>();
+    REQUIRE(codec.name() == "gzip:dict");
+    REQUIRE(&codec == &r->get<plugin_test::ICodec>());
+    REQUIRE(plugin_loaded());
+}
+
+TEST_CASE("transient plugin registrations create fresh instances", "[plugin]") {
+    librtdi::registry reg;
+    reg.add_singleton<plugin_test::IDictionary, Dictionary>();
+    reg.add_plugin<plugin_test::ICodec>(librtdi::lifetime_kind::transient,
+                                        LIBRTDI_TEST_PLUGIN_PATH, "make_gzip_codec",
+                                        librtdi::deps<plugin_test::IDictionary>);
+    auto r = reg.build();
+
+    auto a = r->create<plugin_test::ICodec>();
+    auto b = r->create<plugin_test::ICodec>();
+    REQUIRE(a != b);
+    REQUIRE(a->name() == "gzip:dict");
+}
+
+TEST_CASE("plugin dependency metadata is validated at build", "[plugin]") {
+    librtdi::registry reg;
+    reg.add_plugin<plugin_test::ICodec>(librtdi::lifetime_kind::singleton,
+                                        LIBRTDI_TEST_PLUGIN_PATH, "make_gzip_codec",
+                                        librtdi::deps<plugin_test::IDictionary>);
+    REQUIRE_THROWS_AS(reg.build(), librtdi::not_found);
+}
+
+TEST_CASE("plugin load failures surface on first resolution", "[plugin]") {
+    librtdi::registry reg;
+    reg.add_plugin<plugin_test::ICodec>(librtdi::lifetime_kind::singleton,
+                                        "librtdi_no_such_plugin.so", "make_codec");
+    auto r = reg.build({.eager_singletons = false});
+    REQUIRE_THROWS_AS(r->get<plugin_test::ICodec>(), librtdi::di_error);
+
+    librtdi::registry missing_symbol;
+    missing_symbol.add_plugin<plugin_test::ICodec>(librtdi::lifetime_kind::transient,
+                                                   LIBRTDI_TEST_PLUGIN_PATH, "no_such_entry");
+    auto r2 = missing_symbol.build();
+    REQUIRE_THROWS_AS(r2->create<plugin_test::ICodec>(), librtdi::di_error);
+
+    librtdi::registry empty;
+    empty.add_plugin<plugin_test::ICodec>(librtdi::lifetime_kind::transient,
+                                          LIBRTDI_TEST_PLUGIN_PATH, "make_nothing");
+    auto r3 = empty.build();
+    REQUIRE_THROWS_AS(r3->create<plugin_test::ICodec>(), librtdi::di_error);
+}
@@ -0,0 +1,200 @@
+#include <catch2/catch_test_macros.hpp>
+#include <librtdi.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+static std::atomic<int> g_configs_created{0};
+static std::atomic<int> g_configs_destroyed{0};
+
+struct IConfig {
+    virtual ~IConfig() = default;
+    virtual int version() const = 0;
+};
+
+struct Config : IConfig {
+    int version_;
+    Config() : version_(++g_configs_created) {}
+    ~Config() override { ++g_configs_destroyed; }
+    int version() const override { return version_; }
+};
+
+struct IRouter {
+    virtual ~IRouter() = default;
+    virtual int config_version() const = 0;
+};
+
+struct Router : IRouter {
+    librtdi::refreshable_ref<IConfig> config_;
+    explicit Router(librtdi::refreshable_ref<IConfig> c) : config_(c) {}
+    int config_version() const override { return config_.acquire()->version(); }
+};
+
+struct StaleRouter : IRouter {
+    IConfig& config_;
+    explicit StaleRouter(IConfig& c) : config_(c) {}
+    int config_version() const override { return config_.version(); }
+};
+
+struct IPlain {
+    virtual ~IPlain() = default;
+};
+
+struct Plain : IPlain {};
+
+void reset_counters() {
+    g_configs_created = 0;
+    g_configs_destroyed = 0;
+}
+
+} // namespace
+
+TEST_CASE("refresh publishes a new instance without invalidating guards", "[refreshable]") {
+    reset_counters();
+    librtdi::registry reg;
+    reg.add_refreshable<IConfig, Config>();
+    auto r = reg.build();
+    REQUIRE(g_configs_created == 1);
+
+    auto old_guard = r->acquire<IConfig>();
+    REQUIRE(old_guard->version() == 1);
+    REQUIRE(r->acquire<IConfig>().get() == old_guard.get());
+
+    r->refresh<IConfig>();
+    REQUIRE(r->acquire<IConfig>()->version() == 2);
+
+    // The previous instance lives as long as a guard refers to it
+    REQUIRE(old_guard->version() == 1);
+    REQUIRE(g_configs_destroyed == 0);
+    old_guard = {};
+    REQUIRE(g_configs_destroyed == 1);
+}
+
+TEST_CASE("refreshable slots are lazy without eager_singletons", "[refreshable]") {
+    reset_counters();
+    librtdi::registry reg;
+    reg.add_refreshable<IConfig, Config>("primary");
+    auto r = reg.build({.eager_singletons = false});
+    REQUIRE(g_configs_created == 0);
+
+    REQUIRE(r->acquire<IConfig>("primary")->version() == 1);
+    r->refresh<IConfig>("primary");
+    REQUIRE(r->acquire<IConfig>("primary")->version() == 2);
+}
+
+TEST_CASE("refreshable<T> dependencies observe refreshes", "[refreshable]") {
+    reset_counters();
+    librtdi::registry reg;
+    reg.add_refreshable<IConfig, Config>();
+    reg.add_singleton<IRouter, Router>(librtdi::deps<librtdi::refreshable<IConfig>>);
+    auto r = reg.build();
+
+    auto& router = r->get<IRouter>();
+    REQUIRE(router.config_version() == 1);
+    r->refresh<IConfig>();
+    REQUIRE(router.config_version() == 2);
+}
+
+TEST_CASE("on_refresh subscribers are notified until unsubscribed", "[refreshable]") {
+    reset_counters();
+    librtdi::registry reg;
+    reg.add_refreshable<IConfig, Config>();
+    auto r = reg.build();
+
+    int seen = 0;
+    {
+        auto sub = r->on_refresh<IConfig>([&](IConfig& c) { seen = c.version(); });
+        r->refresh<IConfig>();
+        REQUIRE(seen == 2);
+    }
+    r->refresh<IConfig>();
+    REQUIRE(seen == 2);
+}
+
+TEST_CASE("refreshable misuse is reported", "[refreshable]") {
+    SECTION("get<T>() on a refreshable slot throws") {
+        librtdi::registry reg;
+        reg.add_refreshable<IConfig, Config>();
+        auto r = reg.build({.eager_singletons = false});
+        REQUIRE_THROWS_AS(r->get<IConfig>(), librtdi::di_error);
+    }
+
+    SECTION("acquire<T>() on a plain singleton throws") {
+        librtdi::registry reg;
+        reg.add_singleton<IPlain, Plain>();
+        auto r = reg.build();
+        REQUIRE_THROWS_AS(r->acquire<IPlain>(), librtdi::di_error);
+        REQUIRE_THROWS_AS(r->refresh<IPlain>(), librtdi::di_error);
+    }
+
+    SECTION("unregistered slot throws not_found") {
+        librtdi::registry reg;
+        auto r = reg.build();
+        REQUIRE_THROWS_AS(r->acquire<IConfig>(), librtdi::not_found);
+        REQUIRE_THROWS_AS(r->refresh<IConfig>(), librtdi::not_found);
+    }
+
+    SECTION("plain dependency on a refreshable slot fails validation") {
+        librtdi::registry reg;
+        reg.add_refreshable<IConfig, Config>();
+        reg.add_singleton<IRouter, StaleRouter>(librtdi::deps<IConfig>);
+        REQUIRE_THROWS_AS(reg.build(), librtdi::lifetime_mismatch);
+    }
+
+    SECTION("refreshable<T> dependency on a plain singleton fails validation") {
+        librtdi::registry reg;
+        reg.add_singleton<IConfig, Config>();
+        reg.add_singleton<IRouter, Router>(librtdi::deps<librtdi::refreshable<IConfig>>);
+        REQUIRE_THROWS_AS(reg.build(), librtdi::lifetime_mismatch);
+    }
+}
+
+TEST_CASE("readers run concurrently with refreshes", "[refreshable]") {
+    reset_counters();
+    librtdi::registry reg;
+    reg.add_refreshable<IConfig, Config>();
+    auto r = reg.build();
+
+    std::atomic<bool> stop{false};
+    std::atomic<bool> monotonic{true};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            int last = 0;
+            while (!stop.load()) {
+                auto g = r->acquire<IConfig>();
+                int v = g->version();
+                if (v < last) monotonic = false;
+                last = v;
+            }
+        });
+    }
+    for (int i = 0; i < 200; ++i) {
+        r->refresh<IConfig>();
+    }
+    stop = true;
+    for (auto& t : readers) t.join();
+
+    REQUIRE(monotonic);
+    REQUIRE(r->acquire<IConfig>()->version() == 201);
+    REQUIRE(g_configs_destroyed == 200);
+}
+
+TEST_CASE("child resolvers share inherited refreshable slots", "[refreshable]") {
+    reset_counters();
+    librtdi::registry reg;
+    reg.add_refreshable<IConfig, Config>();
+    auto parent = reg.build();
+
+    librtdi::registry overrides;
+    overrides.add_singleton<IPlain, Plain>();
+    auto child = parent->create_child(std::move(overrides));
+
+    REQUIRE(child->acquire<IConfig>().get() == parent->acquire<IConfig>().get());
+    child->refresh<IConfig>();
+    REQUIRE(parent->acquire<IConfig>()->version() == 2);
+}
@@ -0,0 +1,213 @@
+#include <catch2/catch_test_macros.hpp>
+#include <librtdi.hpp>
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> g_built;
+
+struct IHealth {
+    virtual ~IHealth() = default;
+};
+struct Health : IHealth {
+    Health() { g_built.push_back("health"); }
+};
+
+struct IConfig {
+    virtual ~IConfig() = default;
+};
+struct Config : IConfig {
+    Config() { g_built.push_back("config"); }
+};
+
+struct IRouter {
+    virtual ~IRouter() = default;
+};
+struct Router : IRouter {
+    explicit Router(IConfig&) { g_built.push_back("router"); }
+};
+
+struct ICache {
+    virtual ~ICache() = default;
+};
+struct Cache : ICache {
+    Cache() { g_built.push_back("cache"); }
+};
+
+struct IMisc {
+    virtual ~IMisc() = default;
+};
+struct Misc : IMisc {
+    Misc() { g_built.push_back("misc"); }
+};
+
+struct BrokenCache : ICache {
+    BrokenCache() { throw std::runtime_error("cache warm-up failed"); }
+};
+
+// Runs each task on its own thread; joined on destruction
+struct thread_executor {
+    std::vector<std::thread> threads;
+    librtdi::task_executor fn() {
+        return [this](std::function<void()> task) { threads.emplace_back(std::move(task)); };
+    }
+    ~thread_executor() {
+        for (auto& t : threads) t.join();
+    }
+};
+
+const std::vector<std::string> k_phases{"critical", "serving", "background"};
+
+bool is_ready(const std::shared_future<void>& f) {
+    return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+} // namespace
+
+TEST_CASE("startup phases are built in order with their dependencies", "[phase]") {
+    g_built.clear();
+    librtdi::registry reg;
+    reg.add_singleton<ICache, Cache>();
+    reg.add_singleton<IRouter, Router>(librtdi::deps<IConfig>);
+    reg.add_singleton<IConfig, Config>();
+    reg.add_singleton<IHealth, Health>();
+    reg.add_singleton<IMisc, Misc>();
+    reg.set_startup_phase<IHealth>("critical");
+    reg.set_startup_phase<IRouter>("serving");
+    reg.set_startup_phase<ICache>("background");
+
+    auto r = reg.build({.eager_singletons = false, .startup_phases = k_phases});
+
+    // Config is pulled into "serving" by Router; Misc is unphased and lazy
+    REQUIRE(g_built == std::vector<std::string>{"health", "config", "router", "cache"});
+    for (const auto& p : k_phases) REQUIRE(is_ready(r->phase_ready(p)));
+
+    static_cast<void>(r->get<IMisc>());
+    REQUIRE(g_built.back() == "misc");
+}
+
+TEST_CASE("unphased eager singletons are built with the last phase", "[phase]") {
+    g_built.clear();
+    librtdi::registry reg;
+    reg.add_singleton<IMisc, Misc>();
+    reg.add_singleton<IHealth, Health>();
+    reg.set_startup_phase<IHealth>("critical");
+    auto r = reg.build({.startup_phases = {"critical", "rest"}});
+
+    REQUIRE(g_built == std::vector<std::string>{"health", "misc"});
+}
+
+TEST_CASE("phase_executor lets build() return before slow phases finish", "[phase]") {
+    static std::promise<void> release;
+    release = std::promise<void>();
+    struct SlowCache : ICache {
+        SlowCache() { release.get_future().wait(); }
+    };
+
+    thread_executor pool;
+    librtdi::registry reg;
+    reg.add_singleton<IHealth, Health>();
+    reg.add_singleton<ICache, SlowCache>();
+    reg.set_startup_phase<IHealth>("critical");
+    reg.set_startup_phase<ICache>("background");
+    auto r = reg.build({.startup_phases = {"critical", "background"},
+                        .phase_executor = pool.fn()});
+
+    r->phase_ready("critical").get();
+    REQUIRE_FALSE(is_ready(r->phase_ready("background")));
+
+    // The slow factory does not hold the cache lock
+    static_cast<void>(r->get<IHealth>());
+
+    release.set_value();
+    r->phase_ready("background").get();
+    static_cast<void>(r->get<ICache>());
+}
+
+TEST_CASE("get<T>() during a phase waits for the phase's factory", "[phase]") {
+    static std::promise<void> entered;
+    static std::shared_future<void> release;
+    static int constructed = 0;
+    entered = std::promise<void>();
+    std::promise<void> gate;
+    release = gate.get_future().share();
+    constructed = 0;
+    struct SlowCache : ICache {
+        SlowCache() {
+            if (++constructed == 1) entered.set_value();
+            release.wait();
+        }
+    };
+
+    thread_executor pool;
+    librtdi::registry reg;
+    reg.add_singleton<ICache, SlowCache>();
+    reg.set_startup_phase<ICache>("background");
+    auto r = reg.build({.startup_phases = {"background"}, .phase_executor = pool.fn()});
+
+    entered.get_future().wait();
+    auto concurrent = std::async(std::launch::async, [&] { return &r->get<ICache>(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    gate.set_value();
+
+    r->phase_ready("background").get();
+    REQUIRE(concurrent.get() == &r->get<ICache>());
+    REQUIRE(constructed == 1);
+}
+
+TEST_CASE("a failing phase stops startup", "[phase]") {
+    SECTION("synchronously from build()") {
+        librtdi::registry reg;
+        reg.add_singleton<ICache, BrokenCache>();
+        reg.set_startup_phase<ICache>("serving");
+        REQUIRE_THROWS_AS(reg.build({.startup_phases = k_phases}),
+                          librtdi::resolution_error);
+    }
+
+    SECTION("through the readiness futures") {
+        thread_executor pool;
+        librtdi::registry reg;
+        reg.add_singleton<IHealth, Health>();
+        reg.add_singleton<ICache, BrokenCache>();
+        reg.set_startup_phase<IHealth>("critical");
+        reg.set_startup_phase<ICache>("serving");
+        auto r = reg.build({.startup_phases = k_phases, .phase_executor = pool.fn()});
+
+        REQUIRE_NOTHROW(r->phase_ready("critical").get());
+        REQUIRE_THROWS_AS(r->phase_ready("serving").get(), librtdi::resolution_error);
+        REQUIRE_THROWS_AS(r->phase_ready("background").get(), librtdi::resolution_error);
+    }
+}
+
+TEST_CASE("startup phase names are checked", "[phase]") {
+    SECTION("undeclared phase at build") {
+        librtdi::registry reg;
+        reg.add_singleton<IHealth, Health>();
+        reg.set_startup_phase<IHealth>("critcal");
+        REQUIRE_THROWS_AS(reg.build({.validate_on_build = false,
+                                     .startup_phases = k_phases}),
+                          librtdi::di_error);
+    }
+
+    SECTION("duplicate phase") {
+        librtdi::registry reg;
+        REQUIRE_THROWS_AS(reg.build({.startup_phases = {"a", "a"}}), librtdi::di_error);
+    }
+
+    SECTION("unknown phase_ready()") {
+        librtdi::registry reg;
+        auto r = reg.build({.startup_phases = k_phases});
+        REQUIRE_THROWS_AS(r->phase_ready("warmup"), librtdi::di_error);
+
+        librtdi::registry plain;
+        auto r2 = plain.build();
+        REQUIRE_THROWS_AS(r2->phase_ready("critical"), librtdi::di_error);
+    }
+}
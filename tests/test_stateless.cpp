@@ -0,0 +1,123 @@
+#include <catch2/catch_test_macros.hpp>
+#include <librtdi.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+struct IStrategy {
+    virtual ~IStrategy() = default;
+    virtual int apply(int x) const = 0;
+};
+
+// Only a vtable pointer: stateless
+struct Doubler : IStrategy {
+    static inline int live = 0;
+    static inline bool watched = false;   // last construction ran in a watched factory frame
+    Doubler() noexcept {
+        ++live;
+        watched = librtdi::resolver::construction_stop_token().stop_possible();
+    }
+    ~Doubler() override { --live; }
+    int apply(int x) const override { return 2 * x; }
+};
+
+struct Offset : IStrategy {
+    int by = 3;
+    int apply(int x) const override { return x + by; }
+};
+
+// Empty, non-polymorphic
+struct Tag {};
+
+struct Negating : IStrategy {
+    explicit Negating(librtdi::decorated_ptr<IStrategy> inner) : inner_(std::move(inner)) {}
+    int apply(int x) const override { return -inner_->apply(x); }
+
+private:
+    librtdi::decorated_ptr<IStrategy> inner_;
+};
+
+struct IPipeline {
+    virtual ~IPipeline() = default;
+    virtual int run(int x) const = 0;
+};
+struct Pipeline : IPipeline {
+    explicit Pipeline(std::unique_ptr<IStrategy> s) : s_(std::move(s)) {}
+    int run(int x) const override { return s_->apply(x); }
+
+private:
+    std::unique_ptr<IStrategy> s_;
+};
+
+} // namespace
+
+static_assert(librtdi::stateless_impl<Doubler>);
+static_assert(librtdi::stateless_impl<Tag>);
+static_assert(!librtdi::stateless_impl<Offset>);
+
+TEST_CASE("stateless zero-dep transients are folded at registration", "[stateless]") {
+    librtdi::registry reg;
+    reg.add_transient<IStrategy, Doubler>();
+    reg.add_transient<Tag, Tag>();
+    reg.add_transient<IStrategy, Offset>("offset");
+    reg.add_collection<IStrategy, Doubler>(librtdi::lifetime_kind::transient);
+    reg.add_collection<IStrategy, Doubler>(librtdi::lifetime_kind::singleton);
+
+    const auto& descs = reg.descriptors();
+    REQUIRE(descs.size() == 5);
+    REQUIRE(descs[0].stateless != nullptr);
+    REQUIRE(descs[1].stateless != nullptr);
+    REQUIRE(descs[2].stateless == nullptr);
+    REQUIRE(descs[3].stateless != nullptr);
+    REQUIRE(descs[4].stateless == nullptr);
+}
+
+TEST_CASE("folded transients are distinct owning instances", "[stateless]") {
+    librtdi::registry reg;
+    reg.add_transient<IStrategy, Doubler>();
+    reg.add_collection<IStrategy, Doubler>(librtdi::lifetime_kind::transient);
+    reg.add_transient<IPipeline, Pipeline>(librtdi::deps<librtdi::transient<IStrategy>>);
+    auto r = reg.build();
+
+    {
+        auto a = r->create<IStrategy>();
+        auto b = r->create<IStrategy>();
+        REQUIRE_FALSE(Doubler::watched);
+        REQUIRE(a.get() != b.get());
+        REQUIRE(a->apply(21) == 42);
+        REQUIRE(Doubler::live == 2);
+
+        auto all = r->create_all<IStrategy>();
+        REQUIRE(all.size() == 1);
+        REQUIRE(r->create<IPipeline>()->run(5) == 10);
+        REQUIRE(Doubler::live == 3);
+    }
+    REQUIRE(Doubler::live == 0);
+}
+
+TEST_CASE("decorating a stateless transient drops the fold", "[stateless]") {
+    librtdi::registry reg;
+    reg.add_transient<IStrategy, Doubler>();
+    reg.decorate<IStrategy, Negating>();
+    auto graph = reg.compile();
+
+    REQUIRE(graph->descriptors().front().stateless == nullptr);
+    REQUIRE(graph->instantiate()->create<IStrategy>()->apply(4) == -8);
+}
+
+TEST_CASE("a watched stateless transient runs through its factory", "[stateless]") {
+    librtdi::registry reg;
+    reg.add_transient<IStrategy, Doubler>();
+    auto r = reg.build({.factory_deadline = {.soft = 1s}});
+
+    Doubler::watched = false;
+    REQUIRE(r->create<IStrategy>()->apply(1) == 2);
+    REQUIRE(Doubler::watched);
+    REQUIRE(Doubler::live == 0);
+}
@@ -0,0 +1,165 @@
+#include <catch2/catch_test_macros.hpp>
+#include <librtdi.hpp>
+
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <type_traits>
+
+namespace {
+
+struct IService {
+    virtual ~IService() = default;
+    virtual std::string handle(const std::string& req) const = 0;
+};
+
+struct IConfig {
+    virtual ~IConfig() = default;
+    virtual std::string prefix() const { return "cfg:"; }
+};
+
+struct Config : IConfig {};
+
+struct Service : IService {
+    std::string handle(const std::string& req) const override { return req; }
+};
+
+struct ConfiguredService : IService {
+    IConfig& config;
+    explicit ConfiguredService(IConfig& c) : config(c) {}
+    std::string handle(const std::string& req) const override { return config.prefix() + req; }
+};
+
+// Constructible with or without IConfig
+struct FlexibleService : IService {
+    FlexibleService() = default;
+    explicit FlexibleService(IConfig&) {}
+    std::string handle(const std::string& req) const override { return req; }
+};
+
+template <typename Base>
+struct Metrics : Base {
+    using Base::Base;
+    mutable int calls = 0;
+    std::string handle(const std::string& req) const override {
+        ++calls;
+        return "m(" + Base::handle(req) + ")";
+    }
+};
+
+template <typename Base>
+struct Retry : Base {
+    using Base::Base;
+    std::string handle(const std::string& req) const override {
+        return "r(" + Base::handle(req) + ")";
+    }
+};
+
+struct Logging : IService {
+    librtdi::decorated_ptr<IService> inner_;
+    explicit Logging(librtdi::decorated_ptr<IService> inner) : inner_(std::move(inner)) {}
+    std::string handle(const std::string& req) const override {
+        return "l(" + inner_->handle(req) + ")";
+    }
+};
+
+} // namespace
+
+static_assert(std::is_same_v<librtdi::static_chain<Service, Metrics, Retry>,
+                             Retry<Metrics<Service>>>);
+static_assert(std::is_same_v<librtdi::static_chain<Service>, Service>);
+
+TEST_CASE("decorate_static builds the layers as one object", "[static_chain]") {
+    librtdi::registry reg;
+    reg.add_singleton<IService, Service>();
+    reg.decorate_static<IService, Service, Metrics, Retry>();
+    auto r = reg.build();
+
+    auto& svc = r->get<IService>();
+    REQUIRE(typeid(svc) == typeid(Retry<Metrics<Service>>));
+    REQUIRE(svc.handle("x") == "r(m(x))");
+    REQUIRE(static_cast<Retry<Metrics<Service>>&>(svc).calls == 1);
+}
+
+TEST_CASE("decorate_static passes the registration's dependencies", "[static_chain]") {
+    librtdi::registry reg;
+    reg.add_singleton<IConfig, Config>();
+    reg.add_transient<IService, ConfiguredService>(librtdi::deps<IConfig>);
+    reg.decorate_static<IService, ConfiguredService, Metrics>(librtdi::deps<IConfig>);
+    auto r = reg.build();
+
+    auto a = r->create<IService>();
+    auto b = r->create<IService>();
+    REQUIRE(a.get() != b.get());
+    REQUIRE(a->handle("x") == "m(cfg:x)");
+    REQUIRE(&static_cast<Metrics<ConfiguredService>&>(*a).config == &r->get<IConfig>());
+}
+
+TEST_CASE("decorate_static matches only its implementation", "[static_chain]") {
+    librtdi::registry reg;
+    reg.add_singleton<IConfig, Config>();
+    reg.add_collection<IService, Service>(librtdi::lifetime_kind::singleton);
+    reg.add_collection<IService, ConfiguredService>(librtdi::lifetime_kind::singleton,
+                                                    librtdi::deps<IConfig>);
+    reg.add_singleton<IService, Service>("keyed");
+    reg.decorate_static<IService, Service, Retry>();
+    auto r = reg.build();
+
+    auto all = r->get_all<IService>();
+    REQUIRE(all.size() == 2);
+    REQUIRE(all[0]->handle("x") == "r(x)");
+    REQUIRE(all[1]->handle("x") == "cfg:x");
+    REQUIRE(r->get<IService>("keyed").handle("x") == "r(x)");
+}
+
+TEST_CASE("ordinary decorators wrap the static chain", "[static_chain]") {
+    librtdi::registry reg;
+    reg.add_singleton<IService, Service>();
+    reg.decorate<IService, Logging>();
+    reg.decorate_static<IService, Service, Metrics>();
+    auto r = reg.build();
+
+    REQUIRE(r->get<IService>().handle("x") == "l(m(x))");
+}
+
+TEST_CASE("forwards resolve the chained target", "[static_chain]") {
+    librtdi::registry reg;
+    reg.add_singleton<Service, Service>();
+    reg.forward<IService, Service>();
+    reg.decorate_static<Service, Service, Metrics>();
+    auto r = reg.build();
+
+    REQUIRE(r->get<IService>().handle("x") == "m(x)");
+    REQUIRE(&r->get<IService>() == &r->get<Service>());
+}
+
+TEST_CASE("decorate_static misuse is reported at build", "[static_chain]") {
+    SECTION("dependency lists differ") {
+        librtdi::registry reg;
+        reg.add_singleton<IConfig, Config>();
+        reg.add_singleton<IService, FlexibleService>(librtdi::deps<IConfig>);
+        reg.decorate_static<IService, FlexibleService, Metrics>();
+        try {
+            reg.build();
+            FAIL("expected di_error");
+        } catch (const librtdi::di_error& e) {
+            REQUIRE(std::string(e.what()).find("decorate_static") != std::string::npos);
+        }
+    }
+
+    SECTION("two chains for the same implementation") {
+        librtdi::registry reg;
+        reg.add_singleton<IService, Service>();
+        reg.decorate_static<IService, Service, Metrics>();
+        reg.decorate_static<IService, Service, Retry>();
+        REQUIRE_THROWS_AS(reg.build(), librtdi::di_error);
+    }
+
+    SECTION("registration after build") {
+        librtdi::registry reg;
+        reg.add_singleton<IService, Service>();
+        auto r = reg.build();
+        REQUIRE_THROWS_AS((reg.decorate_static<IService, Service, Metrics>()),
+                          librtdi::di_error);
+    }
+}
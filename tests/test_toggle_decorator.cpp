@@ -0,0 +1,177 @@
+#include <catch2/catch_test_macros.hpp>
+#include <librtdi.hpp>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+namespace {
+
+struct IService {
+    virtual ~IService() = default;
+    virtual std::string handle(const std::string& req) const = 0;
+};
+
+struct Service : IService {
+    std::string handle(const std::string& req) const override { return req; }
+};
+
+struct ISink {
+    virtual ~ISink() = default;
+    virtual std::string tag() const { return "sink"; }
+};
+
+struct Sink : ISink {};
+
+struct Tracing : IService {
+    librtdi::decorated_ptr<IService> inner_;
+    explicit Tracing(librtdi::decorated_ptr<IService> inner) : inner_(std::move(inner)) {}
+    std::string handle(const std::string& req) const override {
+        return "t(" + inner_->handle(req) + ")";
+    }
+};
+
+struct Debug : IService {
+    librtdi::decorated_ptr<IService> inner_;
+    ISink& sink_;
+    Debug(librtdi::decorated_ptr<IService> inner, ISink& sink)
+        : inner_(std::move(inner)), sink_(sink) {}
+    std::string handle(const std::string& req) const override {
+        return sink_.tag() + "(" + inner_->handle(req) + ")";
+    }
+};
+
+struct Logging : IService {
+    librtdi::decorated_ptr<IService> inner_;
+    explicit Logging(librtdi::decorated_ptr<IService> inner) : inner_(std::move(inner)) {}
+    std::string handle(const std::string& req) const override {
+        return "l(" + inner_->handle(req) + ")";
+    }
+};
+
+} // namespace
+
+TEST_CASE("a disabled toggleable decorator is bypassed entirely", "[toggle]") {
+    librtdi::registry reg;
+    reg.add_singleton<IService, Service>();
+    reg.decorate_toggleable<IService, Tracing>();
+    auto r = reg.build();
+
+    auto& plain = r->get<IService>();
+    REQUIRE(typeid(plain) == typeid(Service));
+    REQUIRE(plain.handle("x") == "x");
+
+    REQUIRE(r->set_decorator_enabled<IService, Tracing>(true) == 1);
+    auto& traced = r->get<IService>();
+    REQUIRE(typeid(traced) == typeid(Tracing));
+    REQUIRE(traced.handle("x") == "t(x)");
+
+    REQUIRE(r->set_decorator_enabled<IService, Tracing>(false) == 1);
+    REQUIRE(&r->get<IService>() == &plain);
+
+    // Re-enabling reuses the wrapper built the first time
+    r->set_decorator_enabled<IService, Tracing>(true);
+    REQUIRE(&r->get<IService>() == &traced);
+}
+
+TEST_CASE("transients follow the state at creation", "[toggle]") {
+    librtdi::registry reg;
+    reg.add_transient<IService, Service>();
+    reg.decorate_toggleable<IService, Tracing>(true);
+    auto r = reg.build();
+
+    auto traced = r->create<IService>();
+    r->set_decorator_enabled<IService, Tracing>(false);
+    auto plain = r->create<IService>();
+
+    REQUIRE(traced->handle("x") == "t(x)");
+    REQUIRE(plain->handle("x") == "x");
+}
+
+TEST_CASE("toggleable layers wrap ordinary decorators", "[toggle]") {
+    librtdi::registry reg;
+    reg.add_singleton<ISink, Sink>();
+    reg.add_singleton<IService, Service>();
+    reg.decorate_toggleable<IService, Tracing>();
+    reg.decorate_toggleable<IService, Debug>(librtdi::deps<ISink>);
+    reg.decorate<IService, Logging>();
+    auto r = reg.build();
+
+    REQUIRE(r->get<IService>().handle("x") == "l(x)");
+    r->set_decorator_enabled<IService, Debug>(true);
+    REQUIRE(r->get<IService>().handle("x") == "sink(l(x))");
+    r->set_decorator_enabled<IService, Tracing>(true);
+    REQUIRE(r->get<IService>().handle("x") == "sink(t(l(x)))");
+    r->set_decorator_enabled<IService, Debug>(false);
+    REQUIRE(r->get<IService>().handle("x") == "t(l(x))");
+}
+
+TEST_CASE("toggles can target one keyed registration", "[toggle]") {
+    librtdi::registry reg;
+    reg.add_singleton<IService, Service>("a");
+    reg.add_singleton<IService, Service>("b");
+    reg.decorate_toggleable<IService, Tracing>();
+    auto r = reg.build();
+
+    REQUIRE(r->set_decorator_enabled<IService, Tracing>("a", true) == 1);
+    REQUIRE(r->get<IService>("a").handle("x") == "t(x)");
+    REQUIRE(r->get<IService>("b").handle("x") == "x");
+
+    REQUIRE(r->set_decorator_enabled<IService, Logging>(true) == 0);
+    REQUIRE(r->set_decorator_enabled<IService, Tracing>("missing", true) == 0);
+}
+
+TEST_CASE("toggle state is per resolver", "[toggle]") {
+    librtdi::registry reg;
+    reg.add_singleton<IService, Service>();
+    reg.decorate_toggleable<IService, Tracing>();
+    auto graph = reg.compile();
+    auto r1 = graph->instantiate();
+    auto r2 = graph->instantiate();
+
+    r1->set_decorator_enabled<IService, Tracing>(true);
+    REQUIRE(r1->get<IService>().handle("x") == "t(x)");
+    REQUIRE(r2->get<IService>().handle("x") == "x");
+}
+
+TEST_CASE("forwarded singletons can be toggled", "[toggle]") {
+    librtdi::registry reg;
+    reg.add_singleton<Service, Service>();
+    reg.forward<IService, Service>();
+    reg.decorate_toggleable<IService, Tracing>();
+    auto r = reg.build();
+
+    REQUIRE(&r->get<IService>() == &r->get<Service>());
+    r->set_decorator_enabled<IService, Tracing>(true);
+    REQUIRE(r->get<IService>().handle("x") == "t(x)");
+    REQUIRE(r->get<Service>().handle("x") == "x");
+}
+
+TEST_CASE("toggling while other threads resolve", "[toggle]") {
+    librtdi::registry reg;
+    reg.add_singleton<IService, Service>();
+    reg.decorate_toggleable<IService, Tracing>();
+    auto r = reg.build();
+
+    std::atomic<bool> stop{false};
+    std::atomic<bool> valid{true};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            while (!stop.load()) {
+                auto out = r->get<IService>().handle("x");
+                if (out != "x" && out != "t(x)") valid = false;
+            }
+        });
+    }
+    for (int i = 0; i < 200; ++i) {
+        r->set_decorator_enabled<IService, Tracing>(i % 2 == 0);
+    }
+    stop = true;
+    for (auto& t : readers) t.join();
+
+    REQUIRE(valid);
+}
@@ -1,5 +1,6 @@
 #include <catch2/catch_test_macros.hpp>
 #include <librtdi.hpp>
+#include <memory>
 
 namespace {
 
@@ -135,6 +136,47 @@ TEST_CASE("detect_cycles disabled passes cyclic deps", "[validation]") {
                                 .eager_singletons = false}));
 }
 
+// ---------------------------------------------------------------
+// Without build-time validation a cycle is still caught at resolution
+// ---------------------------------------------------------------
+
+TEST_CASE("unvalidated cycles throw cyclic_dependency at resolution", "[validation]") {
+    SECTION("singletons") {
+        librtdi::registry reg;
+        reg.add_singleton<IX, X>(librtdi::deps<IY>);
+        reg.add_singleton<IY, Y>(librtdi::deps<IX>);
+        auto r = reg.build({.validate_on_build = false,
+                            .detect_cycles = false,
+                            .eager_singletons = false});
+        try {
+            r->get<IX>();
+            FAIL("Expected cyclic_dependency");
+        } catch (const librtdi::cyclic_dependency& e) {
+            auto& cycle = e.cycle();
+            REQUIRE(cycle.size() == 3);
+            REQUIRE(cycle.front() == typeid(IX));
+            REQUIRE(cycle[1] == typeid(IY));
+            REQUIRE(cycle.back() == typeid(IX));
+        }
+        // Nothing half-built was cached; the cycle is reported again
+        REQUIRE_THROWS_AS(r->get<IY>(), librtdi::cyclic_dependency);
+    }
+
+    SECTION("transients") {
+        struct TX : IX {
+            explicit TX(std::unique_ptr<IY> /*y*/) {}
+        };
+        struct TY : IY {
+            explicit TY(std::unique_ptr<IX> /*x*/) {}
+        };
+        librtdi::registry reg;
+        reg.add_transient<IX, TX>(librtdi::deps<librtdi::transient<IY>>);
+        reg.add_transient<IY, TY>(librtdi::deps<librtdi::transient<IX>>);
+        auto r = reg.build({.validate_on_build = false});
+        REQUIRE_THROWS_AS(r->create<IY>(), librtdi::cyclic_dependency);
+    }
+}
+
 // ---------------------------------------------------------------
 // Singleton with transient collection dep is allowed (not captive)
 // ---------------------------------------------------------------
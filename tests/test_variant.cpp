@@ -0,0 +1,152 @@
+#include <catch2/catch_test_macros.hpp>
+#include <librtdi.hpp>
+
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+static int g_simd_created = 0;
+static int g_scalar_created = 0;
+
+struct IKernel {
+    virtual ~IKernel() = default;
+    virtual std::string name() const = 0;
+};
+
+struct SimdKernel : IKernel {
+    SimdKernel() { ++g_simd_created; }
+    std::string name() const override { return "simd"; }
+};
+
+struct ScalarKernel : IKernel {
+    ScalarKernel() { ++g_scalar_created; }
+    std::string name() const override { return "scalar"; }
+};
+
+struct IConfig {
+    virtual ~IConfig() = default;
+    virtual bool on_disk() const { return true; }
+};
+
+struct Config : IConfig {};
+
+struct IStore {
+    virtual ~IStore() = default;
+    virtual std::string name() const = 0;
+};
+
+struct DiskStore : IStore {
+    explicit DiskStore(IConfig&) {}
+    std::string name() const override { return "disk"; }
+};
+
+struct MemoryStore : IStore {
+    std::string name() const override { return "memory"; }
+};
+
+void reset_counters() {
+    g_simd_created = 0;
+    g_scalar_created = 0;
+}
+
+} // namespace
+
+TEST_CASE("build binds the first variant whose predicate holds", "[variant]") {
+    reset_counters();
+    bool has_avx = false;
+    librtdi::registry reg;
+    reg.add_variant<IKernel, SimdKernel>(librtdi::lifetime_kind::singleton,
+                                         [&] { return has_avx; });
+    reg.add_variant<IKernel, ScalarKernel>(librtdi::lifetime_kind::singleton,
+                                           [] { return true; });
+    auto r = reg.build();
+
+    REQUIRE(r->get<IKernel>().name() == "scalar");
+    REQUIRE(g_simd_created == 0);
+    REQUIRE(g_scalar_created == 1);
+    REQUIRE(r->get_all<IKernel>().empty());   // bound into the single slot only
+}
+
+TEST_CASE("later candidates are not evaluated once a slot is bound", "[variant]") {
+    int evaluated = 0;
+    librtdi::registry reg;
+    reg.add_variant<IKernel, SimdKernel>(librtdi::lifetime_kind::transient,
+                                         [&] { ++evaluated; return true; });
+    reg.add_variant<IKernel, ScalarKernel>(librtdi::lifetime_kind::transient,
+                                           [&] { ++evaluated; return true; });
+    auto r = reg.build();
+
+    REQUIRE(evaluated == 1);
+    REQUIRE(r->create<IKernel>()->name() == "simd");
+}
+
+TEST_CASE("variants with deps and keys", "[variant]") {
+    librtdi::registry reg;
+    reg.add_singleton<IConfig, Config>();
+    reg.add_variant<IStore, DiskStore>(librtdi::lifetime_kind::singleton,
+                                       [] { return false; }, librtdi::deps<IConfig>);
+    reg.add_variant<IStore, MemoryStore>(librtdi::lifetime_kind::singleton, [] { return true; });
+    reg.add_variant<IStore, DiskStore>("cold", librtdi::lifetime_kind::singleton,
+                                       [] { return true; }, librtdi::deps<IConfig>);
+    reg.add_variant<IStore, MemoryStore>("cold", librtdi::lifetime_kind::singleton,
+                                         [] { return true; });
+    auto r = reg.build();
+
+    REQUIRE(r->get<IStore>().name() == "memory");
+    REQUIRE(r->get<IStore>("cold").name() == "disk");
+}
+
+TEST_CASE("losing variants are dropped before validation", "[variant]") {
+    // The losing candidate's dependency is not registered
+    librtdi::registry reg;
+    reg.add_variant<IStore, DiskStore>(librtdi::lifetime_kind::singleton,
+                                       [] { return false; }, librtdi::deps<IConfig>);
+    reg.add_variant<IStore, MemoryStore>(librtdi::lifetime_kind::singleton, [] { return true; });
+    auto r = reg.build();
+    REQUIRE(r->get<IStore>().name() == "memory");
+}
+
+TEST_CASE("a slot with no matching variant stays empty", "[variant]") {
+    librtdi::registry reg;
+    reg.add_variant<IKernel, SimdKernel>(librtdi::lifetime_kind::singleton, [] { return false; });
+    auto r = reg.build();
+    REQUIRE(r->try_get<IKernel>() == nullptr);
+}
+
+TEST_CASE("variant misuse is reported", "[variant]") {
+    SECTION("plain registration in a variant slot") {
+        librtdi::registry reg;
+        reg.add_variant<IKernel, SimdKernel>(librtdi::lifetime_kind::singleton, [] { return true; });
+        REQUIRE_THROWS_AS((reg.add_singleton<IKernel, ScalarKernel>()),
+                          librtdi::duplicate_registration);
+    }
+
+    SECTION("variant in a plain slot") {
+        librtdi::registry reg;
+        reg.add_singleton<IKernel, ScalarKernel>();
+        REQUIRE_THROWS_AS((reg.add_variant<IKernel, SimdKernel>(
+                              librtdi::lifetime_kind::singleton, [] { return true; })),
+                          librtdi::duplicate_registration);
+    }
+
+    SECTION("merging a plain registration into a variant slot") {
+        librtdi::registry reg;
+        reg.add_variant<IKernel, SimdKernel>(librtdi::lifetime_kind::singleton, [] { return true; });
+        librtdi::registry other;
+        other.add_singleton<IKernel, ScalarKernel>();
+        REQUIRE_THROWS_AS(reg.merge(std::move(other)), librtdi::duplicate_registration);
+    }
+
+    SECTION("throwing predicate") {
+        librtdi::registry reg;
+        reg.add_variant<IKernel, SimdKernel>(librtdi::lifetime_kind::singleton,
+                                             []() -> bool { throw std::runtime_error("cpuid failed"); });
+        try {
+            reg.build();
+            FAIL("expected di_error");
+        } catch (const librtdi::di_error& e) {
+            REQUIRE(std::string(e.what()).find("cpuid failed") != std::string::npos);
+        }
+    }
+}
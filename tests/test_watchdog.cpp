@@ -0,0 +1,201 @@
+#include <catch2/catch_test_macros.hpp>
+#include <librtdi.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <typeindex>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+struct IDns {
+    virtual ~IDns() = default;
+};
+struct SlowDns : IDns {
+    SlowDns() { std::this_thread::sleep_for(60ms); }
+};
+
+struct IFront {
+    virtual ~IFront() = default;
+};
+struct Front : IFront {
+    explicit Front(IDns&) {}
+};
+
+struct IDisk {
+    virtual ~IDisk() = default;
+};
+
+// Blocks until its construction is cancelled, as an async wait would
+struct HungDisk : IDisk {
+    HungDisk() {
+        auto token = librtdi::resolver::construction_stop_token();
+        if (!token.stop_possible()) throw std::logic_error("not watched");
+        std::mutex m;
+        std::condition_variable_any cv;
+        std::unique_lock lock(m);
+        cv.wait(lock, token, [] { return false; });
+        throw std::runtime_error("disk wait cancelled");
+    }
+};
+
+struct IFast {
+    virtual ~IFast() = default;
+};
+struct Fast : IFast {};
+
+// Blocks in a call that knows nothing of cancellation
+struct IClock {
+    virtual ~IClock() = default;
+};
+struct StuckClock : IClock {
+    static inline std::shared_future<void> release;
+    StuckClock() { release.wait(); }
+};
+
+struct IJournal {
+    virtual ~IJournal() = default;
+};
+struct Journal : IJournal {
+    static inline std::promise<void>* torn_down = nullptr;
+    ~Journal() override { torn_down->set_value(); }
+};
+
+// Collects reports from the watchdog thread
+struct report_sink {
+    std::mutex mutex;
+    std::vector<librtdi::slow_factory_report> reports;
+
+    librtdi::slow_factory_handler fn() {
+        return [this](const librtdi::slow_factory_report& r) {
+            std::lock_guard lock(mutex);
+            reports.push_back(r);
+        };
+    }
+    std::vector<librtdi::slow_factory_report> get() {
+        std::lock_guard lock(mutex);
+        return reports;
+    }
+};
+
+} // namespace
+
+TEST_CASE("a factory past its soft deadline is reported with its chain", "[watchdog]") {
+    report_sink sink;
+    librtdi::registry reg;
+    reg.add_singleton<IDns, SlowDns>();
+    reg.add_singleton<IFront, Front>(librtdi::deps<IDns>);
+    reg.add_singleton<IFast, Fast>();
+    reg.set_construction_deadline<IDns>({.soft = 10ms});
+
+    auto r = reg.build({.eager_singletons = false, .on_slow_factory = sink.fn()});
+    static_cast<void>(r->get<IFast>());
+    static_cast<void>(r->get<IFront>());
+
+    auto reports = sink.get();
+    REQUIRE(reports.size() == 1);
+    const auto& rep = reports.front();
+    REQUIRE(rep.component_type == std::type_index(typeid(IDns)));
+    REQUIRE_FALSE(rep.hard_timeout);
+    REQUIRE(rep.elapsed >= 10ms);
+    REQUIRE(rep.resolution_chain == std::vector<std::type_index>{typeid(IFront), typeid(IDns)});
+    REQUIRE(rep.message.find("soft deadline") != std::string::npos);
+    REQUIRE(rep.message.find("while resolving") != std::string::npos);
+    REQUIRE(std::string(rep.registration_location.file_name()).find("test_watchdog")
+            != std::string::npos);
+}
+
+TEST_CASE("the global deadline applies to every factory", "[watchdog]") {
+    report_sink sink;
+    librtdi::registry reg;
+    reg.add_singleton<IDns, SlowDns>();
+    reg.add_singleton<IFast, Fast>();
+    auto r = reg.build({.factory_deadline = {.soft = 10ms}, .on_slow_factory = sink.fn()});
+
+    auto reports = sink.get();
+    REQUIRE(reports.size() == 1);
+    REQUIRE(reports.front().component_type == std::type_index(typeid(IDns)));
+}
+
+TEST_CASE("a hard timeout fails build() and cancels the factory", "[watchdog]") {
+    report_sink sink;
+    librtdi::registry reg;
+    reg.add_singleton<IFast, Fast>();
+    reg.add_singleton<IDisk, HungDisk>();
+    reg.set_construction_deadline<IDisk>({.hard = 30ms});
+
+    try {
+        static_cast<void>(reg.build({.on_slow_factory = sink.fn()}));
+        FAIL("build() should time out");
+    } catch (const librtdi::construction_timeout& e) {
+        REQUIRE(e.component_type() == std::type_index(typeid(IDisk)));
+        REQUIRE(e.elapsed() >= 30ms);
+        REQUIRE(std::string(e.what()).find("hard deadline") != std::string::npos);
+    }
+
+    auto reports = sink.get();
+    REQUIRE(reports.size() == 1);
+    REQUIRE(reports.front().hard_timeout);
+}
+
+TEST_CASE("a hard timeout fails build() while the factory ignores cancellation",
+          "[watchdog]") {
+    std::promise<void> gate;
+    std::promise<void> torn_down;
+    StuckClock::release = gate.get_future().share();
+    Journal::torn_down = &torn_down;
+
+    report_sink sink;
+    librtdi::registry reg;
+    reg.add_singleton<IJournal, Journal>();
+    reg.add_singleton<IClock, StuckClock>();
+    reg.set_construction_deadline<IClock>({.hard = 30ms});
+
+    const auto start = std::chrono::steady_clock::now();
+    REQUIRE_THROWS_AS(reg.build({.on_slow_factory = sink.fn()}),
+                      librtdi::construction_timeout);
+    REQUIRE(std::chrono::steady_clock::now() - start < 5s);
+
+    // The startup thread held on to the resolver; it is torn down there
+    // once the factory returns
+    auto done = torn_down.get_future();
+    REQUIRE(done.wait_for(0s) == std::future_status::timeout);
+    gate.set_value();
+    REQUIRE(done.wait_for(5s) == std::future_status::ready);
+}
+
+TEST_CASE("a hard timeout fails the remaining startup phases", "[watchdog]") {
+    report_sink sink;
+    std::vector<std::thread> threads;
+    {
+        librtdi::registry reg;
+        reg.add_singleton<IFast, Fast>();
+        reg.add_singleton<IDisk, HungDisk>();
+        reg.set_startup_phase<IFast>("critical");
+        reg.set_startup_phase<IDisk>("background");
+        reg.set_construction_deadline<IDisk>({.hard = 30ms});
+
+        auto r = reg.build({.startup_phases = {"critical", "background"},
+                            .phase_executor = [&](std::function<void()> t) {
+                                threads.emplace_back(std::move(t));
+                            },
+                            .on_slow_factory = sink.fn()});
+
+        REQUIRE_NOTHROW(r->phase_ready("critical").get());
+        REQUIRE_THROWS_AS(r->phase_ready("background").get(), librtdi::construction_timeout);
+    }
+    for (auto& t : threads) t.join();
+}
+
+TEST_CASE("no stop token outside a watched construction", "[watchdog]") {
+    REQUIRE_FALSE(librtdi::resolver::construction_stop_token().stop_possible());
+}